@@ -0,0 +1,199 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNARENA_H__093148__
+#define __SNARENA_H__093148__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A monotonic buffer for the scratch memory of the factorizations.
+*
+* `allocate` moves a pointer forward in the current block ; `deallocate`
+* does nothing. `reset` makes the whole memory available again.
+*
+* When a block is full, a new (larger) block is taken from the heap. At
+* the next `reset`, the blocks are merged in one block large enough for
+* everything that was allocated since the previous `reset`. Thus in a loop
+* like
+* ```
+* SNarena arena;
+* while (...)
+* {
+*     arena.reset();
+*     auto plu=A.getPLU(arena);
+*     auto x=plu.solve(b);
+*     ...
+* }
+* ```
+* only the first iterations touch the heap.
+*
+* `reset` invalidates everything that was allocated in the arena : the objects
+* built with the arena (for example the `SNplu` returned by `getPLU(arena)`)
+* must be destroyed before.
+*
+* An arena is not thread-safe : use one arena per thread.
+**/
+class SNarena
+{
+    private :
+        std::vector<std::unique_ptr<char[]>> data_blocks;
+        std::vector<std::size_t> data_block_sizes;
+        std::size_t data_offset;        // in the last block
+        std::size_t data_used;          // since the last reset, with the alignment losses
+
+        void addBlock(std::size_t bytes);
+    public :
+        /** @brief Allocate a first block of `initial_bytes`. */
+        explicit SNarena(std::size_t initial_bytes=4096);
+
+        SNarena(const SNarena&)=delete;
+        SNarena& operator=(const SNarena&)=delete;
+
+        /** @brief Return `bytes` bytes aligned on `alignment` (a power of two). */
+        void* allocate(std::size_t bytes,std::size_t alignment);
+        void deallocate(void*,std::size_t) {}
+
+        /** @brief Make the whole memory available again. */
+        void reset();
+
+        /** @brief The number of bytes allocated since the last `reset`. */
+        std::size_t getUsed() const;
+        /** @brief The number of bytes taken from the heap. */
+        std::size_t getCapacity() const;
+};
+
+/**
+* @brief A standard allocator that takes its memory in a `SNarena`.
+*
+* ```
+* std::vector<double,SNarenaAllocator<double>> v(n,0,SNarenaAllocator<double>(arena));
+* ```
+**/
+template <class T>
+class SNarenaAllocator
+{
+    template <class U>
+    friend class SNarenaAllocator;
+    private :
+        SNarena* data_arena;
+    public :
+        typedef T value_type;
+
+        explicit SNarenaAllocator(SNarena& arena) : data_arena(&arena) {}
+        template <class U>
+        //cppcheck-suppress noExplicitConstructor
+        SNarenaAllocator(const SNarenaAllocator<U>& other) : data_arena(other.data_arena) {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(data_arena->allocate(n*sizeof(T),alignof(T)));
+        }
+        void deallocate(T* p,std::size_t n)
+        {
+            data_arena->deallocate(p,n*sizeof(T));
+        }
+
+        template <class U>
+        bool operator==(const SNarenaAllocator<U>& other) const
+        {
+            return data_arena==other.data_arena;
+        }
+        template <class U>
+        bool operator!=(const SNarenaAllocator<U>& other) const
+        {
+            return data_arena!=other.data_arena;
+        }
+};
+
+// CONSTRUCTORS -----------------------
+
+inline SNarena::SNarena(std::size_t initial_bytes):
+    data_offset(0),
+    data_used(0)
+{
+    addBlock(std::max(initial_bytes,std::size_t(64)));
+}
+
+// GETTER METHODS -----------------------
+
+inline std::size_t SNarena::getUsed() const
+{
+    return data_used;
+}
+
+inline std::size_t SNarena::getCapacity() const
+{
+    std::size_t capacity=0;
+    for (std::size_t s:data_block_sizes)
+    {
+        capacity+=s;
+    }
+    return capacity;
+}
+
+// ALLOCATION -----------------------
+
+inline void SNarena::addBlock(std::size_t bytes)
+{
+    data_blocks.emplace_back(new char[bytes]);
+    data_block_sizes.push_back(bytes);
+    data_offset=0;
+}
+
+inline void* SNarena::allocate(std::size_t bytes,std::size_t alignment)
+
+    // The blocks come from 'new char[]' : their own alignment is at least
+    // the one of 'std::max_align_t'. The larger alignments are obtained
+    // by skipping bytes.
+
+{
+    const std::uintptr_t base=reinterpret_cast<std::uintptr_t>(data_blocks.back().get());
+    std::uintptr_t p=(base+data_offset+alignment-1)&~std::uintptr_t(alignment-1);
+    if (p+bytes>base+data_block_sizes.back())
+    {
+        addBlock(std::max(2*data_block_sizes.back(),bytes+alignment));
+        return allocate(bytes,alignment);
+    }
+    const std::size_t end=p+bytes-base;
+    data_used+=end-data_offset;
+    data_offset=end;
+    return reinterpret_cast<void*>(p);
+}
+
+inline void SNarena::reset()
+{
+    if (data_blocks.size()>1)
+    {
+        // everything fits in one block at the next turn.
+        const std::size_t capacity=std::max(getCapacity(),data_used);
+        data_blocks.clear();
+        data_block_sizes.clear();
+        addBlock(capacity);
+    }
+    data_offset=0;
+    data_used=0;
+}
+
+#endif
@@ -0,0 +1,523 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNBATCHPLU_H__081536__
+#define __SNBATCHPLU_H__081536__
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "SNplu.h"
+#include "SNvector.h"
+#include "SNmatrices/SNmatrix.h"
+#include "SNmatrices/Mpermutation.h"
+#include "SNmatrices/SNunrolled.h"
+#include "exceptions/SNexceptions.cpp"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief The PLU decompositions of many independent systems of the same size.
+*
+* When one has thousands of small systems (one per cell, for example), calling
+* `getPLU()` on each of them costs much more than the arithmetic itself : virtual
+* calls for each element, range checks, the temporary gaussian matrices, ...
+*
+* This class factorizes all the matrices at once. The elements are recorded
+* "structure of arrays" : the element \f$ (i,j) \f$ of the \f$ b \f$th matrix
+* is stored at
+* ```
+* (j*tp_size+i)*count+b
+* ```
+* so that the same element of all the matrices is contiguous. Each step of the
+* elimination is then a loop over the matrices of the batch, and these loops
+* are vectorized by the compiler (one SIMD lane per matrix). For the sizes
+* up to `unrolled_max_size` (SNunrolled.h), the loops on the lines and
+* columns are written with `unrolledFor` : only the loops over the batch remain.
+*
+* The pivoting is the same as the one of `SNmatrix::getPLU` (the first larger
+* element under the diagonal), so that `getPLU(k)` returns the same
+* decomposition as the one of the \f$ k \f$th matrix.
+*
+* A matrix for which one column is full of zeros (under the diagonal) is
+* not invertible. The elimination continues on the other matrices and
+* `isSingular` returns `true` for that one.
+*
+* ```
+* std::vector<SNmatrix<double,4>> matrices;
+* // populate 'matrices'
+* SNbatchPLU<double,4> batch(matrices);
+* auto solutions=batch.solve(rhs);    // 'rhs' is a std::vector<SNvector<double,4>>
+* ```
+**/
+template <class T,unsigned int tp_size>
+class SNbatchPLU
+{
+    private :
+        const unsigned int data_count;
+        std::vector<T> data_LU;         // L and U together, see `index`.
+        std::vector<unsigned int> data_pivots;  // (c,b) at c*count+b
+        std::vector<bool> data_singular;
+
+        /** Index of the element `(i,j)` of the matrix `b` in `data_LU` */
+        unsigned int index(unsigned int i,unsigned int j,unsigned int b) const;
+
+        /** Perform the elimination on the whole batch. */
+        void factorize();
+        void factorize(std::true_type);     // unrolled
+        void factorize(std::false_type);
+        void swapLines(unsigned int b,unsigned int l1,unsigned int l2);
+
+        // The steps of the elimination, for all the matrices of the batch.
+        void choosePivots(unsigned int c);
+        void computeMultipliers(unsigned int l,unsigned int c);
+        void eliminate(unsigned int l,unsigned int j,unsigned int c);
+
+        // The substitutions on x(i,b) at i*count+b.
+        void substitute(T* x,std::true_type) const;     // unrolled
+        void substitute(T* x,std::false_type) const;
+        void substituteStep(T* x,unsigned int i,unsigned int k) const;
+        void divideByPivot(T* x,unsigned int i) const;
+
+        /**
+         * The solutions of all the systems : x(i,b) at i*count+b. The singular
+         * matrices are skipped (their zero pivots are not used).
+         * */
+        std::vector<T> solveLanes(const std::vector<SNvector<T,tp_size>>& rhs) const;
+    public :
+        /**
+         * @brief Factorize all the given matrices.
+         * */
+        explicit SNbatchPLU(const std::vector<SNmatrix<T,tp_size>>& matrices);
+
+        /** return the number of matrices in the batch. */
+        unsigned int getCount() const;
+
+        /** return true if the `k`th matrix has a column full of zeros. */
+        bool isSingular(unsigned int k) const;
+
+        /**
+         * @brief Solve \f$ A_kx_k=b_k \f$ for each matrix of the batch.
+         *
+         * The right hand sides are given in the same order as the matrices.
+         * Throws `IncompatibleBatchSizeException` if the number of vectors
+         * is not the number of matrices.
+         *
+         * The systems whose matrix is singular (see `isSingular`) are not
+         * solved : their solution is the zero vector.
+         * */
+        std::vector<SNvector<T,tp_size>> solve(const std::vector<SNvector<T,tp_size>>& rhs) const;
+
+        /**
+         * @brief Put in `solutions[k]` the solution of \f$ A_kx_k=b_k \f$ and
+         * return `SNstatus::ok`.
+         *
+         * When at least one matrix is singular, return `SNstatus::singular` : the
+         * other systems are solved and `solutions[k]` is not modified when
+         * the `k`th matrix is singular.
+         *
+         * Throws `IncompatibleBatchSizeException` if `rhs` or `solutions`
+         * does not have one vector per matrix.
+         * */
+        SNstatus solve(const std::vector<SNvector<T,tp_size>>& rhs,std::vector<SNvector<T,tp_size>>& solutions) const;
+
+        /**
+         * @brief Return the inverses of all the matrices of the batch.
+         *
+         * The column \f$ j \f$ of all the inverses is obtained by one `solve`
+         * against \f$ e_j \f$, vectorized over the batch. This is meant
+         * for the setup of block preconditioners. As in `solve`, the
+         * singular matrices are skipped : their "inverse" is zero.
+         *
+         * Prints a warning (once) : see `SNplu::inverse`.
+         * */
+        std::vector<SNmatrix<T,tp_size>> inverse() const;
+
+        /**
+         * @brief Return the PLU decomposition of the `k`th matrix as a
+         * `SNplu` object.
+         *
+         * Throws `BatchIndexOutOfRangeException` if there is no `k`th matrix.
+         * */
+        SNplu<T,tp_size> getPLU(unsigned int k) const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+SNbatchPLU<T,tp_size>::SNbatchPLU(const std::vector<SNmatrix<T,tp_size>>& matrices):
+    data_count(matrices.size()),
+    data_LU(tp_size*tp_size*matrices.size()),
+    data_pivots(tp_size*matrices.size()),
+    data_singular(matrices.size(),false)
+{
+    for (unsigned int b=0;b<data_count;++b)
+    {
+        for (m_num i=0;i<tp_size;++i)
+        {
+            for (m_num j=0;j<tp_size;++j)
+            {
+                data_LU[index(i,j,b)]=matrices[b].get(i,j);
+            }
+        }
+    }
+    factorize();
+}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+unsigned int SNbatchPLU<T,tp_size>::index(unsigned int i,unsigned int j,unsigned int b) const
+{
+    return (j*tp_size+i)*data_count+b;
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNbatchPLU<T,tp_size>::getCount() const
+{
+    return data_count;
+}
+
+template <class T,unsigned int tp_size>
+bool SNbatchPLU<T,tp_size>::isSingular(unsigned int k) const
+{
+    return data_singular.at(k);
+}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNbatchPLU<T,tp_size>::getPLU(unsigned int k) const
+{
+    if (k>=data_count)
+    {
+        snThrow(BatchIndexOutOfRangeException(k,data_count));
+    }
+
+    std::array<unsigned int,tp_size> pivots;
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        pivots[c]=data_pivots[c*data_count+k];
+    }
+    return pluFromCompactLU<T,tp_size>(pivots,[this,k](unsigned int i,unsigned int j)
+        {
+            return data_LU[index(i,j,k)];
+        });
+}
+
+// MATHEMATICS -----------------------
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::swapLines(unsigned int b,unsigned int l1,unsigned int l2)
+{
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        std::swap(data_LU[index(l1,j,b)],data_LU[index(l2,j,b)]);
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::choosePivots(unsigned int c)
+
+    // matrix by matrix : the first larger element under the diagonal.
+
+{
+    const unsigned int N=data_count;
+    for (unsigned int b=0;b<N;++b)
+    {
+        unsigned int max_line=c;
+        T max_val=std::abs(data_LU[index(c,c,b)]);
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            if (std::abs(data_LU[index(l,c,b)])>max_val)
+            {
+                max_val=std::abs(data_LU[index(l,c,b)]);
+                max_line=l;
+            }
+        }
+        data_pivots[c*N+b]=max_line;
+        if (max_val==0)    // a column full of zero's
+        {
+            data_singular[b]=true;
+        }
+        else
+        {
+            swapLines(b,c,max_line);
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::computeMultipliers(unsigned int l,unsigned int c)
+{
+    const unsigned int N=data_count;
+    const T* pivot=data_LU.data()+index(c,c,0);
+    T* mult=data_LU.data()+index(l,c,0);
+    for (unsigned int b=0;b<N;++b)
+    {
+        mult[b] = (pivot[b]!=0) ? mult[b]/pivot[b] : 0;
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::eliminate(unsigned int l,unsigned int j,unsigned int c)
+{
+    const unsigned int N=data_count;
+    T* target=data_LU.data()+index(l,j,0);
+    const T* mult=data_LU.data()+index(l,c,0);
+    const T* source=data_LU.data()+index(c,j,0);
+    for (unsigned int b=0;b<N;++b)
+    {
+        target[b]-=mult[b]*source[b];
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::factorize()
+
+    // The same steps as in `SNmatrix::getPLU`, but each operation is done
+    // on the whole batch before to pass to the next one :
+    // - the pivot is searched (and the lines swapped) matrix by matrix,
+    // - the elimination is a loop over the batch (the innermost loop),
+    //   which is the contiguous direction in `data_LU`.
+    //
+    // The multipliers are stored in place of the eliminated elements.
+    // Since the whole lines are swapped, these multipliers follow the
+    // later permutations, as in the product "mL.swapLines; mL*=G.inverse()"
+    // of `getPLU`.
+
+{
+    factorize(SNuseUnrolled<tp_size>());
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::factorize(std::false_type)
+{
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        choosePivots(c);
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            computeMultipliers(l,c);
+            for (unsigned int j=c+1;j<tp_size;++j)
+            {
+                eliminate(l,j,c);
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::factorize(std::true_type)
+{
+    unrolledFor<0,tp_size>([&](auto c)
+        {
+            constexpr unsigned int cc=decltype(c)::value;
+            choosePivots(cc);
+            unrolledFor<cc+1,tp_size>([&](auto l)
+                {
+                    constexpr unsigned int ll=decltype(l)::value;
+                    computeMultipliers(ll,cc);
+                    unrolledFor<cc+1,tp_size>([&](auto j)
+                        {
+                            constexpr unsigned int jj=decltype(j)::value;
+                            eliminate(ll,jj,cc);
+                        });
+                });
+        });
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::substituteStep(T* x,unsigned int i,unsigned int k) const
+
+    // x(i,:) -= LU(i,k,:)*x(k,:)
+
+{
+    const unsigned int N=data_count;
+    T* target=x+i*N;
+    const T* lu=data_LU.data()+index(i,k,0);
+    const T* source=x+k*N;
+    for (unsigned int b=0;b<N;++b)
+    {
+        target[b]-=lu[b]*source[b];
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::divideByPivot(T* x,unsigned int i) const
+
+    // A zero pivot is the one of a singular matrix : that lane is
+    // divided by 1 and its result is not used.
+
+{
+    const unsigned int N=data_count;
+    T* target=x+i*N;
+    const T* pivot=data_LU.data()+index(i,i,0);
+    for (unsigned int b=0;b<N;++b)
+    {
+        target[b]/= (pivot[b]!=0) ? pivot[b] : 1;
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::substitute(T* x,std::false_type) const
+{
+    // Ly=Pb (the diagonal of L is 1)
+    for (unsigned int i=1;i<tp_size;++i)
+    {
+        for (unsigned int k=0;k<i;++k)
+        {
+            substituteStep(x,i,k);
+        }
+    }
+
+    // Ux=y
+    for (unsigned int i=tp_size;i-- >0;)
+    {
+        for (unsigned int k=i+1;k<tp_size;++k)
+        {
+            substituteStep(x,i,k);
+        }
+        divideByPivot(x,i);
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNbatchPLU<T,tp_size>::substitute(T* x,std::true_type) const
+{
+    unrolledFor<1,tp_size>([&](auto i)
+        {
+            constexpr unsigned int ii=decltype(i)::value;
+            unrolledFor<0,ii>([&](auto k)
+                {
+                    substituteStep(x,ii,decltype(k)::value);
+                });
+        });
+    unrolledFor<0,tp_size>([&](auto r)
+        {
+            constexpr unsigned int ii=tp_size-1-decltype(r)::value;
+            unrolledFor<ii+1,tp_size>([&](auto k)
+                {
+                    substituteStep(x,ii,decltype(k)::value);
+                });
+            divideByPivot(x,ii);
+        });
+}
+
+template <class T,unsigned int tp_size>
+std::vector<T> SNbatchPLU<T,tp_size>::solveLanes(const std::vector<SNvector<T,tp_size>>& rhs) const
+{
+    const unsigned int N=data_count;
+    if (rhs.size()!=N)
+    {
+        snThrow(IncompatibleBatchSizeException(N,rhs.size()));
+    }
+
+    // x(i,b) is stored at i*N+b
+    std::vector<T> x(tp_size*N);
+    for (unsigned int b=0;b<N;++b)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            x[i*N+b]=rhs[b].get(i);
+        }
+    }
+
+    // the permutation
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        for (unsigned int b=0;b<N;++b)
+        {
+            std::swap(x[c*N+b],x[data_pivots[c*N+b]*N+b]);
+        }
+    }
+
+    substitute(x.data(),SNuseUnrolled<tp_size>());
+    return x;
+}
+
+template <class T,unsigned int tp_size>
+std::vector<SNvector<T,tp_size>> SNbatchPLU<T,tp_size>::solve(const std::vector<SNvector<T,tp_size>>& rhs) const
+{
+    const unsigned int N=data_count;
+    const std::vector<T> x=solveLanes(rhs);
+    std::vector<SNvector<T,tp_size>> solutions(N);
+    for (unsigned int b=0;b<N;++b)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            solutions[b].at(i)= data_singular[b] ? 0 : x[i*N+b];
+        }
+    }
+    return solutions;
+}
+
+template <class T,unsigned int tp_size>
+SNstatus SNbatchPLU<T,tp_size>::solve(const std::vector<SNvector<T,tp_size>>& rhs,std::vector<SNvector<T,tp_size>>& solutions) const
+{
+    const unsigned int N=data_count;
+    if (solutions.size()!=N)
+    {
+        snThrow(IncompatibleBatchSizeException(N,solutions.size()));
+    }
+    const std::vector<T> x=solveLanes(rhs);
+    SNstatus status=SNstatus::ok;
+    for (unsigned int b=0;b<N;++b)
+    {
+        if (data_singular[b])
+        {
+            status=SNstatus::singular;
+            continue;
+        }
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            solutions[b].at(i)=x[i*N+b];
+        }
+    }
+    return status;
+}
+
+template <class T,unsigned int tp_size>
+std::vector<SNmatrix<T,tp_size>> SNbatchPLU<T,tp_size>::inverse() const
+{
+    explicitInverseWarning("Warning : computing explicit inverses. Are you sure that 'solve' is not enough ?");
+
+    std::vector<SNmatrix<T,tp_size>> inverses(data_count);
+    std::vector<SNvector<T,tp_size>> e_j(data_count);
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        for (unsigned int b=0;b<data_count;++b)
+        {
+            for (unsigned int i=0;i<tp_size;++i)
+            {
+                e_j[b].at(i)= (i==j) ? 1 : 0;
+            }
+        }
+        auto columns=solve(e_j);
+        for (unsigned int b=0;b<data_count;++b)
+        {
+            for (m_num i=0;i<tp_size;++i)
+            {
+                inverses[b].at(i,j)=columns[b].get(i);
+            }
+        }
+    }
+    return inverses;
+}
+
+#endif
@@ -0,0 +1,254 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNCONSTEXPRPLU_H__102641__
+#define __SNCONSTEXPRPLU_H__102641__
+
+#include <array>
+#include <utility>
+
+#include "SNplu.h"
+#include "SNvector.h"
+#include "SNmatrices/SNlayout.h"
+#include "SNmatrices/SNmatrix.h"
+#include "SNmatrices/Mpermutation.h"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief PLU decomposition that can be computed at compile time.
+*
+* For the small matrices known at compile time (stencil coefficients,
+* 3x3 transforms, ...), the factors are computed by the compiler and
+* stored in the binary :
+* ```
+* constexpr SNmatrix<double,3> A(std::array<double,9>{{ ... }});
+* constexpr SNconstexprPLU<double,3> plu(A);
+* ...
+* auto x=plu.solve(b);      // no factorization at run time
+* ```
+*
+* The factors are packed in one matrix : \f$ U \f$ on and above the
+* diagonal, \f$ L \f$ (whose diagonal is 1) under the diagonal. The pivots
+* are the ones of `SNmatrix::getPLU` : `getPLU()` returns the same
+* decomposition.
+*
+* The object can also be built at run time; it then needs no heap
+* memory, unlike `SNplu`.
+**/
+template <class T,unsigned int tp_size>
+class SNconstexprPLU
+{
+    private :
+        SNmatrix<T,tp_size> data_LU;
+        Mpermutation<tp_size> data_P;
+
+        // The elimination works on plain arrays (see `SNconstexprArray`).
+        class Factors
+        {
+            public :
+                SNconstexprArray<T,tp_size*tp_size> LU;     // column major
+                SNconstexprArray<unsigned int,tp_size> rows;
+
+                constexpr T& a(unsigned int i,unsigned int j)
+                {
+                    return LU.values[j*tp_size+i];
+                }
+        };
+
+        static constexpr T absolute(const T& x);
+
+        template <class Layout>
+        static constexpr Factors factorize(const SNmatrix<T,tp_size,Layout>& A);
+
+        template <std::size_t... Is,std::size_t... Ks>
+        constexpr SNconstexprPLU(const Factors& F,std::index_sequence<Is...>,std::index_sequence<Ks...>);
+    public :
+        template <class Layout>
+        constexpr explicit SNconstexprPLU(const SNmatrix<T,tp_size,Layout>& A);
+
+        /** @brief The packed factors \f$ L \f$ and \f$ U \f$. */
+        constexpr const SNmatrix<T,tp_size>& getLU() const;
+
+        /** 
+         * @brief The permutation : the line `i` of \f$ LU \f$ is the line
+         * `image(i)` of the matrix.
+         * */
+        constexpr const Mpermutation<tp_size>& getMpermutation() const;
+
+        /** @brief Return the solution of \f$ Ax=b \f$. */
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b) const;
+
+        /** @brief Unpack the factors. */
+        SNplu<T,tp_size> getPLU() const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+template <class Layout>
+constexpr SNconstexprPLU<T,tp_size>::SNconstexprPLU(const SNmatrix<T,tp_size,Layout>& A):
+    SNconstexprPLU(factorize(A),std::make_index_sequence<tp_size*tp_size>(),std::make_index_sequence<tp_size>())
+{}
+
+template <class T,unsigned int tp_size>
+template <std::size_t... Is,std::size_t... Ks>
+constexpr SNconstexprPLU<T,tp_size>::SNconstexprPLU(const Factors& F,std::index_sequence<Is...>,std::index_sequence<Ks...>):
+    data_LU(std::array<T,tp_size*tp_size>{{F.LU.values[Is]...}}),
+    data_P(std::array<unsigned int,tp_size>{{F.rows.values[Ks]...}})
+{}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+constexpr const SNmatrix<T,tp_size>& SNconstexprPLU<T,tp_size>::getLU() const
+{
+    return data_LU;
+}
+
+template <class T,unsigned int tp_size>
+constexpr const Mpermutation<tp_size>& SNconstexprPLU<T,tp_size>::getMpermutation() const
+{
+    return data_P;
+}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNconstexprPLU<T,tp_size>::getPLU() const
+{
+    SNlowerTriangular<T,tp_size> mL(1);
+    SNupperTriangular<T,tp_size> mU;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<i;++j)
+        {
+            mL.at(i,j)=data_LU(i,j);
+        }
+        for (m_num j=i;j<tp_size;++j)
+        {
+            mU.at(i,j)=data_LU(i,j);
+        }
+    }
+    return SNplu<T,tp_size>(data_P,mL,mU);
+}
+
+// MATHEMATICS -----------------------
+
+template <class T,unsigned int tp_size>
+constexpr T SNconstexprPLU<T,tp_size>::absolute(const T& x)
+{
+    // std::abs is not constexpr
+    return x<0 ? -x : x;
+}
+
+template <class T,unsigned int tp_size>
+template <class Layout>
+constexpr typename SNconstexprPLU<T,tp_size>::Factors SNconstexprPLU<T,tp_size>::factorize(const SNmatrix<T,tp_size,Layout>& A)
+
+    // As in `SNmatrix::getPLU` : the pivot is the first larger element
+    // under the diagonal and a column full of zero's is skipped. The whole
+    // lines are swapped, so that the multipliers already in L follow.
+
+{
+    Factors F{};
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            F.a(i,j)=A(i,j);
+        }
+    }
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        F.rows.values[k]=k;
+    }
+
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        unsigned int max_line=c;
+        T max_val=0;
+        for (unsigned int l=c;l<tp_size;++l)
+        {
+            if (absolute(F.a(l,c))>max_val)
+            {
+                max_val=absolute(F.a(l,c));
+                max_line=l;
+            }
+        }
+        if (max_val==0)
+        {
+            continue;
+        }
+        if (max_line!=c)
+        {
+            for (unsigned int j=0;j<tp_size;++j)
+            {
+                const T tmp=F.a(c,j);
+                F.a(c,j)=F.a(max_line,j);
+                F.a(max_line,j)=tmp;
+            }
+            const unsigned int tmp=F.rows.values[c];
+            F.rows.values[c]=F.rows.values[max_line];
+            F.rows.values[max_line]=tmp;
+        }
+
+        const T pivot=F.a(c,c);
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            const T m=F.a(l,c)/pivot;
+            F.a(l,c)=m;
+            for (unsigned int j=c+1;j<tp_size;++j)
+            {
+                F.a(l,j)-=m*F.a(c,j);
+            }
+        }
+    }
+    return F;
+}
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNconstexprPLU<T,tp_size>::solve(const SNvector<T,tp_size>& b) const
+{
+    // P^{-1}b
+    SNvector<T,tp_size> x=data_P.gather(b);
+
+    // Lz=y, the diagonal of L is 1
+    for (m_num i=0;i<tp_size;++i)
+    {
+        T acc=x.get(i);
+        for (m_num k=0;k<i;++k)
+        {
+            acc-=data_LU(i,k)*x.get(k);
+        }
+        x.at(i)=acc;
+    }
+
+    // Ux=z
+    for (unsigned int i=tp_size;i-- >0;)
+    {
+        T acc=x.get(i);
+        for (m_num k=i+1;k<tp_size;++k)
+        {
+            acc-=data_LU(i,k)*x.get(k);
+        }
+        x.at(i)=acc/data_LU(i,i);
+    }
+    return x;
+}
+
+#endif
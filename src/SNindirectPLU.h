@@ -0,0 +1,211 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNINDIRECTPLU_H__174455__
+#define __SNINDIRECTPLU_H__174455__
+
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "SNplu.h"
+#include "SNvector.h"
+#include "SNmatrices/SNmatrix.h"
+#include "SNmatrices/Mpermutation.h"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief PLU decomposition in which the lines are never swapped.
+*
+* `SNmatrix::swapLines` copies two whole lines, and since the storage is
+* column major each swap touches `tp_size` cache lines. Here the lines stay
+* where they are : the logical line \f$ i \f$ is the physical line
+* `rows[i]` and pivoting only swaps two entries of `rows`.
+*
+* The factors can be used through `solve` without ever being put in
+* order. `getPLU` gathers the lines once and returns the same
+* decomposition as `SNmatrix::getPLU` (same pivots).
+*
+* ```
+* auto lu=A.getIndirectPLU();
+* auto x=lu.solve(b);
+* ```
+**/
+template <class T,unsigned int tp_size>
+class SNindirectPLU
+{
+    private :
+        std::vector<T> data;        // column major, the lines are not permuted.
+        std::array<unsigned int,tp_size> data_rows;
+
+        /** the element (i,j) of the physical storage */
+        T& a(unsigned int i,unsigned int j);
+        T a(unsigned int i,unsigned int j) const;
+
+        void factorize();
+    public :
+        explicit SNindirectPLU(const SNgeneric<T,tp_size>& A);
+
+        /**
+         * @brief The permutation : the logical line `i` is the line
+         * `image(i)` of the matrix.
+         * */
+        Mpermutation<tp_size> getMpermutation() const;
+
+        /** @brief Return the solution of \f$ Ax=b \f$. */
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b) const;
+
+        /** @brief Put the lines in order and return the decomposition. */
+        SNplu<T,tp_size> getPLU() const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+SNindirectPLU<T,tp_size>::SNindirectPLU(const SNgeneric<T,tp_size>& A):
+    data(tp_size*tp_size)
+{
+    for (m_num i=0;i<tp_size;++i)
+    {
+        data_rows[i]=i;
+        for (m_num j=0;j<tp_size;++j)
+        {
+            a(i,j)=A.get(i,j);
+        }
+    }
+    factorize();
+}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+T& SNindirectPLU<T,tp_size>::a(unsigned int i,unsigned int j)
+{
+    return data[j*tp_size+i];
+}
+
+template <class T,unsigned int tp_size>
+T SNindirectPLU<T,tp_size>::a(unsigned int i,unsigned int j) const
+{
+    return data[j*tp_size+i];
+}
+
+template <class T,unsigned int tp_size>
+Mpermutation<tp_size> SNindirectPLU<T,tp_size>::getMpermutation() const
+{
+    return Mpermutation<tp_size>(data_rows);
+}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNindirectPLU<T,tp_size>::getPLU() const
+{
+    SNlowerTriangular<T,tp_size> mL(1);
+    SNupperTriangular<T,tp_size> mU;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        const unsigned int r=data_rows[i];
+        for (m_num j=0;j<i;++j)
+        {
+            mL.at(i,j)=a(r,j);
+        }
+        for (m_num j=i;j<tp_size;++j)
+        {
+            mU.at(i,j)=a(r,j);
+        }
+    }
+    return SNplu<T,tp_size>(getMpermutation(),mL,mU);
+}
+
+// MATHEMATICS -----------------------
+
+template <class T,unsigned int tp_size>
+void SNindirectPLU<T,tp_size>::factorize()
+
+    // As in `SNmatrix::getPLU` : the pivot is the first larger element
+    // under the diagonal and a column full of zero's is skipped.
+
+{
+    std::array<unsigned int,tp_size>& rows=data_rows;
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        unsigned int max_line=c;
+        T max_val=std::abs(a(rows[c],c));
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            if (std::abs(a(rows[l],c))>max_val)
+            {
+                max_val=std::abs(a(rows[l],c));
+                max_line=l;
+            }
+        }
+        if (max_val==0)
+        {
+            continue;
+        }
+        std::swap(rows[c],rows[max_line]);
+
+        const T pivot=a(rows[c],c);
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            a(rows[l],c)/=pivot;
+        }
+        for (unsigned int j=c+1;j<tp_size;++j)
+        {
+            const T u_cj=a(rows[c],j);
+            for (unsigned int l=c+1;l<tp_size;++l)
+            {
+                a(rows[l],j)-=a(rows[l],c)*u_cj;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNindirectPLU<T,tp_size>::solve(const SNvector<T,tp_size>& b) const
+{
+    const std::array<unsigned int,tp_size>& rows=data_rows;
+    SNvector<T,tp_size> x;
+
+    // Ly=P^{-1}b
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        T acc=b.get(rows[i]);
+        for (unsigned int k=0;k<i;++k)
+        {
+            acc-=a(rows[i],k)*x.get(k);
+        }
+        x.at(i)=acc;
+    }
+
+    // Ux=y
+    for (unsigned int i=tp_size;i-- >0;)
+    {
+        T acc=x.get(i);
+        for (unsigned int k=i+1;k<tp_size;++k)
+        {
+            acc-=a(rows[i],k)*x.get(k);
+        }
+        x.at(i)=acc/a(rows[i],i);
+    }
+    return x;
+}
+
+#endif
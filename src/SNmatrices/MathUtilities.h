@@ -31,14 +31,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 template <class T,unsigned int tp_size>
 class SNgeneric;
 
+/**
+* @brief Check at compile time that the two matrices have the same size.
+*
+* The sizes are template parameters : comparing or multiplying matrices
+* with different sizes does not compile (there is nothing to check at
+* run time).
+**/
 template <class U,unsigned int s,class V,unsigned int t>
-void checkSizeCompatibility(const SNgeneric<U,s>&A, const SNgeneric<V,t>&B )
+void checkSizeCompatibility(const SNgeneric<U,s>&, const SNgeneric<V,t>&)
 {
-    // the 'getSize' test is in order to avoid 'unused parameter warning'.
-    if (s!=t or A.getSize()!=B.getSize() )
-    {
-        throw IncompatibleMatrixSizeException(s,t);
-    }
+    static_assert(s==t,"The two matrices must have the same size.");
 }
 
 template <class T,class U>
@@ -99,7 +99,7 @@ MelementaryPermutation<tp_size>::MelementaryPermutation(const unsigned int A,con
 {
     if (getA() > tp_size or getB() > tp_size)
     {
-        throw OutOfRangeConstructionElementaryPermutationException(A,B,tp_size);
+        snThrow(OutOfRangeConstructionElementaryPermutationException(A,B,tp_size));
     }
 }
     
@@ -108,7 +108,7 @@ unsigned int MelementaryPermutation<tp_size>::image(const unsigned int k) const
 {
     if (k>tp_size)
     {
-        throw PermutationIdexoutOfRangeException(k,tp_size);
+        snThrow(PermutationIdexoutOfRangeException(k,tp_size));
     }
     if (k==getA())
     {
@@ -0,0 +1,246 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MLAZYPERMUTATION_H__171033__
+#define __MLAZYPERMUTATION_H__171033__
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "../exceptions/SNexceptions.cpp"
+#include "MgenericPermutation.h"
+#include "MelementaryPermutation.h"
+#include "Mpermutation.h"
+#include "../SNvector.h"
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A product of transpositions \f$ \tau_1\tau_2\ldots\tau_m \f$ which
+* is not computed.
+*
+* Multiplying by a `MelementaryPermutation` only records it : \f$ O(1) \f$
+* instead of the \f$ O(n) \f$ of `Mpermutation * MelementaryPermutation`.
+* While recording, the transpositions are fused : a transposition
+* \f$ (a,a) \f$ is dropped and \f$ \tau\tau \f$ cancels.
+*
+* The images are materialized only when someone asks for one (`image`,
+* `toMpermutation`). The materialized array is kept and only the
+* transpositions recorded since the previous query are applied on it.
+* Because of that cache, `image` is not thread-safe.
+*
+* `applyInPlace` and `applyInverseInPlace` replay the transpositions on a
+* vector, without materializing anything.
+**/
+template <unsigned int tp_size>
+class MlazyPermutation : public MgenericPermutation<tp_size>
+{
+    private:
+        std::vector<std::pair<unsigned int,unsigned int>> data_transpositions;
+
+        // The product of the 'data_materialized' first transpositions.
+        mutable std::array<unsigned int,tp_size> data_images;
+        mutable unsigned int data_materialized;
+
+        void materialize() const;
+    public :
+        /** @brief The no-argument constructors initializes to identity */
+        MlazyPermutation();
+
+        //cppcheck-suppress noExplicitConstructor
+        MlazyPermutation(const MelementaryPermutation<tp_size>& p);
+
+        /** @brief Right-multiply by the transposition \f$ (a,b) \f$ */
+        void multiply(unsigned int a,unsigned int b);
+
+        MlazyPermutation<tp_size>& operator*=(const MelementaryPermutation<tp_size>& p);
+        MlazyPermutation<tp_size>& operator*=(const MlazyPermutation<tp_size>& p);
+
+        /** @brief The number of recorded transpositions (after fusion) */
+        unsigned int getTranspositionCount() const;
+
+        unsigned int image(const unsigned int k) const override;
+
+        Mpermutation<tp_size> toMpermutation() const;
+
+        /** @brief Replace `v` by \f$ Pv \f$ : the last transposition acts first. */
+        template <class T>
+        void applyInPlace(SNvector<T,tp_size>& v) const;
+        /** @brief Replace `v` by \f$ P^{-1}v \f$ : the first transposition acts first. */
+        template <class T>
+        void applyInverseInPlace(SNvector<T,tp_size>& v) const;
+};
+
+// CONSTRUCTORS ----------------------------
+
+template <unsigned int tp_size>
+MlazyPermutation<tp_size>::MlazyPermutation() :
+    data_materialized(0)
+{
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        data_images[k]=k;
+    }
+}
+
+template <unsigned int tp_size>
+MlazyPermutation<tp_size>::MlazyPermutation(const MelementaryPermutation<tp_size>& p) :
+    MlazyPermutation()
+{
+    multiply(p.getA(),p.getB());
+}
+
+// GETTER METHODS ----------------------------
+
+template <unsigned int tp_size>
+unsigned int MlazyPermutation<tp_size>::getTranspositionCount() const
+{
+    return data_transpositions.size();
+}
+
+// PRODUCTS -------------------------------
+
+template <unsigned int tp_size>
+void MlazyPermutation<tp_size>::multiply(unsigned int a,unsigned int b)
+{
+    if (a>=tp_size or b>=tp_size)
+    {
+        snThrow(OutOfRangeConstructionElementaryPermutationException(a,b,tp_size));
+    }
+    if (a==b)
+    {
+        return;
+    }
+    if (a>b)
+    {
+        std::swap(a,b);
+    }
+    if (!data_transpositions.empty() and data_transpositions.back()==std::make_pair(a,b))
+    {
+        data_transpositions.pop_back();
+        if (data_materialized>data_transpositions.size())
+        {
+            // The cancelled transposition was already applied : undo it.
+            std::swap(data_images[a],data_images[b]);
+            data_materialized=data_transpositions.size();
+        }
+        return;
+    }
+    data_transpositions.push_back(std::make_pair(a,b));
+}
+
+template <unsigned int tp_size>
+MlazyPermutation<tp_size>& MlazyPermutation<tp_size>::operator*=(const MelementaryPermutation<tp_size>& p)
+{
+    multiply(p.getA(),p.getB());
+    return *this;
+}
+
+template <unsigned int tp_size>
+MlazyPermutation<tp_size>& MlazyPermutation<tp_size>::operator*=(const MlazyPermutation<tp_size>& p)
+{
+    // copy first : 'p' could be '*this'.
+    auto transpositions=p.data_transpositions;
+    for (const auto& t:transpositions)
+    {
+        multiply(t.first,t.second);
+    }
+    return *this;
+}
+
+/**
+ *\brief Product `MlazyPermutation` * `MelementaryPermutation` : no computation.
+ * */
+template <unsigned int tp_size>
+MlazyPermutation<tp_size> operator*(MlazyPermutation<tp_size> A, const MelementaryPermutation<tp_size>& B)
+{
+    A*=B;
+    return A;
+}
+
+/**
+ *\brief Product `MlazyPermutation` * `MlazyPermutation` : the
+ * concatenation of the transpositions.
+ * */
+template <unsigned int tp_size>
+MlazyPermutation<tp_size> operator*(MlazyPermutation<tp_size> A, const MlazyPermutation<tp_size>& B)
+{
+    A*=B;
+    return A;
+}
+
+// MATERIALIZATION -------------------------------
+
+template <unsigned int tp_size>
+void MlazyPermutation<tp_size>::materialize() const
+
+    // Right-multiplying by the transposition (a,b) amounts to swap
+    // the images of a and b.
+
+{
+    for (;data_materialized<data_transpositions.size();++data_materialized)
+    {
+        const auto& t=data_transpositions[data_materialized];
+        std::swap(data_images[t.first],data_images[t.second]);
+    }
+}
+
+template <unsigned int tp_size>
+unsigned int MlazyPermutation<tp_size>::image(const unsigned int k) const
+{
+    if (k>=tp_size)
+    {
+        snThrow(PermutationIdexoutOfRangeException(k,tp_size));
+    }
+    materialize();
+    return data_images[k];
+}
+
+template <unsigned int tp_size>
+Mpermutation<tp_size> MlazyPermutation<tp_size>::toMpermutation() const
+{
+    materialize();
+    return Mpermutation<tp_size>(data_images);
+}
+
+// ACTION ON THE VECTORS -------------------------------
+
+template <unsigned int tp_size>
+template <class T>
+void MlazyPermutation<tp_size>::applyInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    for (auto t=data_transpositions.rbegin();t!=data_transpositions.rend();++t)
+    {
+        std::swap(x[t->first],x[t->second]);
+    }
+}
+
+template <unsigned int tp_size>
+template <class T>
+void MlazyPermutation<tp_size>::applyInverseInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    for (const auto& t:data_transpositions)
+    {
+        std::swap(x[t.first],x[t.second]);
+    }
+}
+
+#endif
@@ -20,9 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __MPERMUTATION_H_121119__
 
 #include <array>
+#include <utility>
 
 #include "MgenericPermutation.h"
 #include "MelementaryPermutation.h"
+#include "../SNvector.h"
 
 // THE CLASS HEADER -----------------------------------------
 
@@ -38,6 +40,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 * \f$ 1\to a \f$, \f$ 2\to b \f$, \f$ 3\to c \f$ and \f$ 4\to d \f$.
 *
 * The numbers  \f$  a,b,c,d\f$ must be different and in [0,tp_size].
+*
+* As a matrix, \f$ P_{ij}=1 \f$ when \f$ image(j)=i \f$. Thus \f$ Pv \f$ moves
+* the element \f$ j \f$ of \f$ v \f$ to the place \f$ image(j) \f$ (a
+* "scatter") and \f$ P^{-1}v \f$ takes the element \f$ image(j) \f$ of
+* \f$ v \f$ to the place \f$ j \f$ (a "gather").
+*
+* `applyInPlace` and `applyInverseInPlace` use \f$ O(1) \f$ memory, but
+* finding the leaders of the cycles costs \f$ O(n^2) \f$ in the worst case
+* (for example a single cycle of length \f$ n \f$) ; `gather` and
+* `scatter` are \f$ O(n) \f$ and use a second vector.
 */
 template <unsigned int tp_size>
 class Mpermutation : public MgenericPermutation<tp_size>
@@ -47,11 +59,13 @@ class Mpermutation : public MgenericPermutation<tp_size>
     friend std::ostream& operator<<(std::ostream&, Mpermutation<s>);
     template <unsigned int s>
     friend bool operator==(const Mpermutation<s>&,const Mpermutation<s>&);
+    template <unsigned int s>
+    friend Mpermutation<s> operator*(const Mpermutation<s>&,const Mpermutation<s>&);
     
     private:
         std::array<unsigned int,tp_size> data;
     public :
-        explicit Mpermutation(const std::array<unsigned int,tp_size>& d); 
+        constexpr explicit Mpermutation(const std::array<unsigned int,tp_size>& d); 
 
         //cppcheck-suppress noExplicitConstructor
         Mpermutation(const MelementaryPermutation<tp_size>& ); 
@@ -62,6 +76,12 @@ class Mpermutation : public MgenericPermutation<tp_size>
         /** @brief return by value the image of `k` */
         unsigned int image(const unsigned int k) const override;
 
+        /** 
+         * @brief Unchecked image of `k`, usable in a constant expression
+         * (`image` and `operator()` are virtual).
+         * */
+        constexpr unsigned int operator[](const unsigned int k) const;
+
         /** 
          * \brief return by reference the image of 'k' by the permutation
          *
@@ -71,6 +91,48 @@ class Mpermutation : public MgenericPermutation<tp_size>
 
         /** Return the inverse permutation */
         Mpermutation<tp_size> inverse() const;
+
+        /** 
+         * @brief Return the signature (1 or -1) of the permutation.
+         *
+         * A cycle of length \f$ l \f$ is the product of \f$ l-1 \f$
+         * transpositions. The signature is computed in \f$ O(n) \f$ by
+         * following the cycles.
+         * */
+        int signature() const;
+
+        /**
+         * @brief Call `swap(i,j)` for a sequence of transpositions which,
+         * applied in that order to the elements of a vector, produce
+         * \f$ Pv \f$.
+         *
+         * Each cycle is done starting from its smallest element (the
+         * "leader"), so that no memory is needed to remember the visited
+         * elements. Checking that `k` is a leader costs the walk from
+         * `k` to a smaller element of its cycle.
+         * */
+        template <class F>
+        void forEachSwap(F swap) const;
+
+        /**
+         * @brief Same as `forEachSwap` for \f$ P^{-1}v \f$.
+         * */
+        template <class F>
+        void forEachInverseSwap(F swap) const;
+
+        /** @brief Replace `v` by \f$ Pv \f$, with \f$ O(1) \f$ memory and \f$ O(n^2) \f$ time in the worst case. */
+        template <class T>
+        void applyInPlace(SNvector<T,tp_size>& v) const;
+        /** @brief Replace `v` by \f$ P^{-1}v \f$, with \f$ O(1) \f$ memory. */
+        template <class T>
+        void applyInverseInPlace(SNvector<T,tp_size>& v) const;
+
+        /** @brief Return \f$ P^{-1}v \f$ : `out[j]=v[image(j)]`. */
+        template <class T>
+        SNvector<T,tp_size> gather(const SNvector<T,tp_size>& v) const;
+        /** @brief Return \f$ Pv \f$ : `out[image(j)]=v[j]`. */
+        template <class T>
+        SNvector<T,tp_size> scatter(const SNvector<T,tp_size>& v) const;
 };
 
 
@@ -82,17 +144,23 @@ unsigned int& Mpermutation<tp_size>::at(const unsigned int k)
     return data.at(k);
 }
 
+template <unsigned int tp_size>
+constexpr unsigned int Mpermutation<tp_size>::operator[](const unsigned int k) const
+{
+    return data[k];
+}
+
 // CONSTRUCTOR ----------------------------
 
 template <unsigned int tp_size>
-Mpermutation<tp_size>::Mpermutation(const std::array<unsigned int,tp_size>& d) :
+constexpr Mpermutation<tp_size>::Mpermutation(const std::array<unsigned int,tp_size>& d) :
     data(d)
 {
     for (unsigned int k=0;k<tp_size;++k)
     {
         if (d.at(k)>tp_size-1) // Mpermutation<4> permutes the set {0,1,2,3}.
         {
-            throw PermutationIdexoutOfRangeException(k,tp_size);
+            snThrow(PermutationIdexoutOfRangeException(k,tp_size));
         }
     }
 }
@@ -100,6 +168,10 @@ Mpermutation<tp_size>::Mpermutation(const std::array<unsigned int,tp_size>& d) :
 template <unsigned int tp_size>
 Mpermutation<tp_size>::Mpermutation(const MelementaryPermutation<tp_size>& p )
 {
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        at(k)=k;
+    }
     this->at(  p.getA()  )=p.getB();
     this->at(  p.getB()  )=p.getA();
 }
@@ -130,9 +202,9 @@ std::ostream& operator<<(std::ostream& stream, Mpermutation<s> perm)
 template <unsigned int tp_size>
 unsigned int Mpermutation<tp_size>::image(const unsigned int k) const
 {
-    if (k>tp_size)
+    if (k>=tp_size)
     {
-        throw PermutationIdexoutOfRangeException(k,tp_size);
+        snThrow(PermutationIdexoutOfRangeException(k,tp_size));
     }
     return data.at(k);
 }
@@ -149,4 +221,133 @@ Mpermutation<tp_size> Mpermutation<tp_size>::inverse () const
     return inv;
 }
 
+template <unsigned int tp_size>
+int Mpermutation<tp_size>::signature() const
+{
+    std::array<bool,tp_size> visited{};
+    unsigned int transpositions=0;
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        unsigned int length=0;
+        for (unsigned int l=k;!visited[l];l=data[l])
+        {
+            visited[l]=true;
+            ++length;
+        }
+        if (length>0)
+        {
+            transpositions+=length-1;
+        }
+    }
+    return (transpositions%2==0) ? 1 : -1;
+}
+
+// ACTION ON THE VECTORS -------------------------------
+
+template <unsigned int tp_size>
+template <class F>
+void Mpermutation<tp_size>::forEachSwap(F swap) const
+
+    // On the cycle k -> a -> b -> k, the swaps (k,a) then (k,b) send
+    // the element of 'k' to 'a', the one of 'a' to 'b' and the one
+    // of 'b' to 'k'.
+
+{
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        unsigned int j=data[k];
+        while (j>k)
+        {
+            j=data[j];
+        }
+        if (j!=k)   // 'k' is not the leader of its cycle
+        {
+            continue;
+        }
+        for (j=data[k];j!=k;j=data[j])
+        {
+            swap(k,j);
+        }
+    }
+}
+
+template <unsigned int tp_size>
+template <class F>
+void Mpermutation<tp_size>::forEachInverseSwap(F swap) const
+
+    // On the cycle k -> a -> b -> k, the swaps (k,a) then (a,b) send
+    // the element of 'a' to 'k', the one of 'b' to 'a' and the one
+    // of 'k' to 'b'.
+
+{
+    for (unsigned int k=0;k<tp_size;++k)
+    {
+        unsigned int j=data[k];
+        while (j>k)
+        {
+            j=data[j];
+        }
+        if (j!=k)
+        {
+            continue;
+        }
+        unsigned int previous=k;
+        for (j=data[k];j!=k;j=data[j])
+        {
+            swap(previous,j);
+            previous=j;
+        }
+    }
+}
+
+template <unsigned int tp_size>
+template <class T>
+void Mpermutation<tp_size>::applyInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    forEachSwap([x](unsigned int i,unsigned int j)
+        {
+            std::swap(x[i],x[j]);
+        });
+}
+
+template <unsigned int tp_size>
+template <class T>
+void Mpermutation<tp_size>::applyInverseInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    forEachInverseSwap([x](unsigned int i,unsigned int j)
+        {
+            std::swap(x[i],x[j]);
+        });
+}
+
+template <unsigned int tp_size>
+template <class T>
+SNvector<T,tp_size> Mpermutation<tp_size>::gather(const SNvector<T,tp_size>& v) const
+{
+    SNvector<T,tp_size> out;
+    const T* in=v.data();
+    T* res=out.data();
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        res[j]=in[data[j]];
+    }
+    return out;
+}
+
+template <unsigned int tp_size>
+template <class T>
+SNvector<T,tp_size> Mpermutation<tp_size>::scatter(const SNvector<T,tp_size>& v) const
+{
+    SNvector<T,tp_size> out;
+    const T* in=v.data();
+    T* res=out.data();
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        res[data[j]]=in[j];
+    }
+    return out;
+}
+
 #endif
@@ -0,0 +1,190 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __MPIVOTSEQUENCE_H__160412__
+#define __MPIVOTSEQUENCE_H__160412__
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "../exceptions/SNexceptions.cpp"
+#include "MgenericPermutation.h"
+#include "Mpermutation.h"
+#include "../SNvector.h"
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A permutation recorded as the sequence of the line swaps of a
+* Gaussian elimination (the `ipiv` array of LAPACK).
+*
+* At the step \f$ c \f$ the line \f$ c \f$ is swapped with the line
+* `getPivot(c)` (\f$ \geq c \f$). The permutation is the product
+* \f[
+*   P=\tau_0\tau_1\ldots\tau_{n-1}
+* \f]
+* where \f$ \tau_c \f$ is the transposition of \f$ c \f$ and `getPivot(c)`,
+* as in `SNmatrix::getPLU`.
+*
+* Recording a swap costs \f$ O(1) \f$ while composing an `Mpermutation`
+* with a `MelementaryPermutation` costs \f$ O(n) \f$. The swaps are also
+* the cheapest way to apply \f$ P^{-1} \f$ to a vector (this is what
+* LAPACK's `laswp` does).
+*
+* `image` costs \f$ O(n) \f$ : use `toMpermutation` when many images are needed.
+**/
+template <unsigned int tp_size>
+class MpivotSequence : public MgenericPermutation<tp_size>
+{
+    private:
+        std::array<unsigned int,tp_size> data_pivots;
+    public :
+        /** @brief The no-argument constructors initializes to identity */
+        MpivotSequence();
+
+        /**
+         * @brief Construct from the pivots : at the step `c` the line `c`
+         * is swapped with `pivots[c]`.
+         * */
+        explicit MpivotSequence(const std::array<unsigned int,tp_size>& pivots);
+
+        /** @brief Record that the line `c` is swapped with the line `p`. */
+        void setPivot(unsigned int c,unsigned int p);
+        unsigned int getPivot(unsigned int c) const;
+
+        unsigned int image(const unsigned int k) const override;
+
+        /** @brief Return the same permutation as an array of images, in \f$ O(n) \f$. */
+        Mpermutation<tp_size> toMpermutation() const;
+
+        /** @brief Replace `v` by \f$ Pv \f$. */
+        template <class T>
+        void applyInPlace(SNvector<T,tp_size>& v) const;
+        /** @brief Replace `v` by \f$ P^{-1}v \f$. */
+        template <class T>
+        void applyInverseInPlace(SNvector<T,tp_size>& v) const;
+};
+
+// CONSTRUCTORS ----------------------------
+
+template <unsigned int tp_size>
+MpivotSequence<tp_size>::MpivotSequence()
+{
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        data_pivots[c]=c;
+    }
+}
+
+template <unsigned int tp_size>
+MpivotSequence<tp_size>::MpivotSequence(const std::array<unsigned int,tp_size>& pivots)
+{
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        setPivot(c,pivots[c]);
+    }
+}
+
+// GETTER/SETTER METHODS ----------------------------
+
+template <unsigned int tp_size>
+void MpivotSequence<tp_size>::setPivot(unsigned int c,unsigned int p)
+{
+    if (c>=tp_size or p>=tp_size)
+    {
+        snThrow(PermutationIdexoutOfRangeException(std::max(c,p),tp_size));
+    }
+    data_pivots[c]=p;
+}
+
+template <unsigned int tp_size>
+unsigned int MpivotSequence<tp_size>::getPivot(unsigned int c) const
+{
+    return data_pivots.at(c);
+}
+
+// MATHEMATICS -------------------------------
+
+template <unsigned int tp_size>
+unsigned int MpivotSequence<tp_size>::image(const unsigned int k) const
+
+    // P(k)=tau_0(tau_1(...tau_{n-1}(k)))
+
+{
+    if (k>=tp_size)
+    {
+        snThrow(PermutationIdexoutOfRangeException(k,tp_size));
+    }
+    unsigned int i=k;
+    for (unsigned int c=tp_size;c-- >0;)
+    {
+        if (i==c)
+        {
+            i=data_pivots[c];
+        }
+        else if (i==data_pivots[c])
+        {
+            i=c;
+        }
+    }
+    return i;
+}
+
+template <unsigned int tp_size>
+Mpermutation<tp_size> MpivotSequence<tp_size>::toMpermutation() const
+
+    // Right-multiplying a permutation by the transposition (c,p) amounts
+    // to swap its images of c and p.
+
+{
+    std::array<unsigned int,tp_size> images;
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        images[c]=c;
+    }
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        std::swap(images[c],images[data_pivots[c]]);
+    }
+    return Mpermutation<tp_size>(images);
+}
+
+template <unsigned int tp_size>
+template <class T>
+void MpivotSequence<tp_size>::applyInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    for (unsigned int c=tp_size;c-- >0;)
+    {
+        std::swap(x[c],x[data_pivots[c]]);
+    }
+}
+
+template <unsigned int tp_size>
+template <class T>
+void MpivotSequence<tp_size>::applyInverseInPlace(SNvector<T,tp_size>& v) const
+{
+    T* x=v.data();
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        std::swap(x[c],x[data_pivots[c]]);
+    }
+}
+
+#endif
@@ -0,0 +1,345 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNBLOCKVIEW_H__142518__
+#define __SNBLOCKVIEW_H__142518__
+
+#include <type_traits>
+
+#include "m_num.h"
+#include "SNlayout.h"
+#include "../exceptions/SNexceptions.cpp"
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A non-owning view on the block of a `SNmatrix` made of the lines
+* `first_line` to `first_line+lines-1` and the columns `first_column` to
+* `first_column+columns-1`.
+*
+* As the line and column views (SNview.h), a block view reads and writes
+* the matrix itself : the operations below work in place, without copying
+* the blocks. They are the building blocks of the blocked algorithms :
+* ```
+* // Schur complement  A22 <- A22 - A21*A12
+* A.getBlockView(k,k,n-k,n-k).multiplyAdd(-1,A.getBlockView(k,0,n-k,k),A.getBlockView(0,k,k,n-k));
+* ```
+*
+* The indices given to `get`, `at` and `operator()` are relative to the block.
+* The block operations throw `IncompatibleBlockSizeException` when the
+* extents do not fit. The blocks given as argument must not overlap
+* the block which is modified.
+*
+* The constness is the one of `T` : a view on a const matrix has the
+* type `SNblockView<const T,...>`.
+**/
+template <class T,unsigned int tp_size,class Layout=ColumnMajor>
+class SNblockView
+{
+    private :
+        T* data;
+        m_num first_line;
+        m_num first_column;
+        m_num lines;
+        m_num columns;
+
+        template <class U,unsigned int s,class L>
+        void checkSameSize(const SNblockView<U,s,L>& B) const;
+    public :
+        typedef typename std::remove_const<T>::type value_type;
+
+        /** throws `SNoutOfRangeException` if the block does not fit in the matrix. */
+        SNblockView(T* data,m_num first_line,m_num first_column,m_num lines,m_num columns);
+
+        m_num getFirstLine() const;
+        m_num getFirstColumn() const;
+        m_num getLines() const;
+        m_num getColumns() const;
+
+        /** Unchecked access to the element (i,j) of the block. */
+        T& operator()(m_num i,m_num j) const;
+
+        /** throw `SNoutOfRangeException` if (i,j) is out of the block */
+        value_type get(m_num i,m_num j) const;
+        T& at(m_num i,m_num j) const;
+
+        /** @brief The sub-block with the given offset (relative to this block) and extent. */
+        SNblockView<T,tp_size,Layout> getBlockView(m_num first_line,m_num first_column,m_num lines,m_num columns) const;
+
+        /** @brief Multiply the block by `m`. */
+        void scale(const value_type& m) const;
+
+        /** @brief This block becomes \f$ this+mB \f$. */
+        template <class U,unsigned int s,class L>
+        void addScaled(const value_type& m,const SNblockView<U,s,L>& B) const;
+
+        /**
+         * @brief This block becomes \f$ this+\alpha AB \f$ (the GEMM of BLAS).
+         *
+         * The loops are ordered for the column major layouts : the inner loop
+         * runs along a column of this block and of `A`.
+         * */
+        template <class U,unsigned int s,class L,class V,unsigned int r,class M>
+        void multiplyAdd(const value_type& alpha,const SNblockView<U,s,L>& A,const SNblockView<V,r,M>& B) const;
+
+        /**
+         * @brief This block becomes \f$ L^{-1}\cdot this \f$ where \f$ L \f$ is
+         * the lower triangular part of the square block `L` (the TRSM of BLAS).
+         *
+         * With `unit_diagonal`, the diagonal of `L` is not read and taken as 1 :
+         * this is the case of the L of a packed LU.
+         * */
+        template <class U,unsigned int s,class L>
+        void leftSolveLower(const SNblockView<U,s,L>& mL,bool unit_diagonal=false) const;
+
+        /**
+         * @brief This block becomes \f$ U^{-1}\cdot this \f$ where \f$ U \f$ is
+         * the upper triangular part of the square block `U`.
+         * */
+        template <class U,unsigned int s,class L>
+        void leftSolveUpper(const SNblockView<U,s,L>& mU) const;
+
+        /**
+         * @brief This block becomes \f$ this\cdot U^{-1} \f$ where \f$ U \f$ is
+         * the upper triangular part of the square block `U`.
+         * */
+        template <class U,unsigned int s,class L>
+        void rightSolveUpper(const SNblockView<U,s,L>& mU) const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size,class Layout>
+SNblockView<T,tp_size,Layout>::SNblockView(T* d,m_num fl,m_num fc,m_num l,m_num c):
+    data(d),
+    first_line(fl),
+    first_column(fc),
+    lines(l),
+    columns(c)
+{
+    if (fl+l>tp_size or fc+c>tp_size)
+    {
+        snThrow(SNoutOfRangeException(fl+l,fc+c,tp_size));
+    }
+}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNblockView<T,tp_size,Layout>::getFirstLine() const
+{
+    return first_line;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNblockView<T,tp_size,Layout>::getFirstColumn() const
+{
+    return first_column;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNblockView<T,tp_size,Layout>::getLines() const
+{
+    return lines;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNblockView<T,tp_size,Layout>::getColumns() const
+{
+    return columns;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNblockView<T,tp_size,Layout>::operator()(m_num i,m_num j) const
+{
+    return data[Layout::index(first_line+i,first_column+j,tp_size)];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+typename SNblockView<T,tp_size,Layout>::value_type SNblockView<T,tp_size,Layout>::get(m_num i,m_num j) const
+{
+    return at(i,j);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNblockView<T,tp_size,Layout>::at(m_num i,m_num j) const
+{
+    if (i>=lines or j>=columns)
+    {
+        snThrow(SNoutOfRangeException(first_line+i,first_column+j,tp_size));
+    }
+    return (*this)(i,j);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNblockView<T,tp_size,Layout> SNblockView<T,tp_size,Layout>::getBlockView(m_num fl,m_num fc,m_num l,m_num c) const
+{
+    if (fl+l>lines or fc+c>columns)
+    {
+        snThrow(SNoutOfRangeException(first_line+fl+l,first_column+fc+c,tp_size));
+    }
+    return SNblockView<T,tp_size,Layout>(data,first_line+fl,first_column+fc,l,c);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L>
+void SNblockView<T,tp_size,Layout>::checkSameSize(const SNblockView<U,s,L>& B) const
+{
+    if (B.getLines()!=lines or B.getColumns()!=columns)
+    {
+        snThrow(IncompatibleBlockSizeException(lines,columns,B.getLines(),B.getColumns()));
+    }
+}
+
+// BLOCK OPERATIONS -----------------------
+
+template <class T,unsigned int tp_size,class Layout>
+void SNblockView<T,tp_size,Layout>::scale(const value_type& m) const
+{
+    for (m_num j=0;j<columns;++j)
+    {
+        for (m_num i=0;i<lines;++i)
+        {
+            (*this)(i,j)*=m;
+        }
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L>
+void SNblockView<T,tp_size,Layout>::addScaled(const value_type& m,const SNblockView<U,s,L>& B) const
+{
+    checkSameSize(B);
+    for (m_num j=0;j<columns;++j)
+    {
+        for (m_num i=0;i<lines;++i)
+        {
+            (*this)(i,j)+=m*B(i,j);
+        }
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L,class V,unsigned int r,class M>
+void SNblockView<T,tp_size,Layout>::multiplyAdd(const value_type& alpha,const SNblockView<U,s,L>& A,const SNblockView<V,r,M>& B) const
+
+    // C(:,j) += sum_k (alpha*B(k,j)) A(:,k)
+
+{
+    if (A.getLines()!=lines or B.getColumns()!=columns)
+    {
+        snThrow(IncompatibleBlockSizeException(lines,columns,A.getLines(),B.getColumns()));
+    }
+    if (A.getColumns()!=B.getLines())
+    {
+        snThrow(IncompatibleBlockSizeException(A.getLines(),A.getColumns(),B.getLines(),B.getColumns()));
+    }
+    for (m_num j=0;j<columns;++j)
+    {
+        for (m_num k=0;k<A.getColumns();++k)
+        {
+            const value_type b=alpha*B(k,j);
+            for (m_num i=0;i<lines;++i)
+            {
+                (*this)(i,j)+=A(i,k)*b;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L>
+void SNblockView<T,tp_size,Layout>::leftSolveLower(const SNblockView<U,s,L>& mL,bool unit_diagonal) const
+
+    // Forward substitution on each column, column oriented :
+    // once x_k is known, it is eliminated from the lines under k.
+
+{
+    if (mL.getLines()!=lines or mL.getColumns()!=lines)
+    {
+        snThrow(IncompatibleBlockSizeException(mL.getLines(),mL.getColumns(),lines,columns));
+    }
+    for (m_num j=0;j<columns;++j)
+    {
+        for (m_num k=0;k<lines;++k)
+        {
+            if (!unit_diagonal)
+            {
+                (*this)(k,j)/=mL(k,k);
+            }
+            const value_type x=(*this)(k,j);
+            for (m_num i=k+1;i<lines;++i)
+            {
+                (*this)(i,j)-=mL(i,k)*x;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L>
+void SNblockView<T,tp_size,Layout>::leftSolveUpper(const SNblockView<U,s,L>& mU) const
+{
+    if (mU.getLines()!=lines or mU.getColumns()!=lines)
+    {
+        snThrow(IncompatibleBlockSizeException(mU.getLines(),mU.getColumns(),lines,columns));
+    }
+    for (m_num j=0;j<columns;++j)
+    {
+        for (unsigned int k=lines;k-- >0;)
+        {
+            (*this)(k,j)/=mU(k,k);
+            const value_type x=(*this)(k,j);
+            for (m_num i=0;i<k;++i)
+            {
+                (*this)(i,j)-=mU(i,k)*x;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U,unsigned int s,class L>
+void SNblockView<T,tp_size,Layout>::rightSolveUpper(const SNblockView<U,s,L>& mU) const
+
+    // X U = B, column by column : X(:,j)=(B(:,j)-sum_{k<j} U(k,j) X(:,k))/U(j,j)
+
+{
+    if (mU.getLines()!=columns or mU.getColumns()!=columns)
+    {
+        snThrow(IncompatibleBlockSizeException(lines,columns,mU.getLines(),mU.getColumns()));
+    }
+    for (m_num j=0;j<columns;++j)
+    {
+        for (m_num k=0;k<j;++k)
+        {
+            const value_type u=mU(k,j);
+            for (m_num i=0;i<lines;++i)
+            {
+                (*this)(i,j)-=u*(*this)(i,k);
+            }
+        }
+        const value_type d=mU(j,j);
+        for (m_num i=0;i<lines;++i)
+        {
+            (*this)(i,j)/=d;
+        }
+    }
+}
+
+#endif
@@ -130,7 +130,7 @@ void SNgaussian<T,tp_size>::setColumn(const m_num& col)
 {
     if (col>tp_size-1)
     {
-        throw OutOfRangeColumnNumber("The specified column number is larger than the size of the matrix.");
+        snThrow(OutOfRangeColumnNumber("The specified column number is larger than the size of the matrix."));
     }
     data_column=col;
 }
@@ -147,11 +147,8 @@ template <class T,unsigned int tp_size>
 template <class U, unsigned int s>
 void SNgaussian<T,tp_size>::populate_from(const SNgeneric<U,s>& A)
 {
+    static_assert(s==tp_size,"The matrix must have the size of the Gaussian matrix.");
     m_num column=getColumn();
-    if (s!=tp_size)
-    {
-        throw IncompatibleMatrixSizeException(tp_size,s);
-    }
 
     T m = A.get(column,column);
     for (m_num i=column+1;i<tp_size;++i)
@@ -236,13 +233,13 @@ T& SNgaussian<T,tp_size>::_at(const m_num& i,const m_num& j)
 {
     if (data_column==tp_size+1)
     {
-        throw NotInitializedMemberException("You are trying to populate a 'SNgaussian' before to initialize the member 'data_column'. Use setColumn().");
+        snThrow(NotInitializedMemberException("You are trying to populate a 'SNgaussian' before to initialize the member 'data_column'. Use setColumn()."));
     }
 
     SpecialValue<T> sv=checkForSpecialElements(i,j);
     if (sv.special)
     {
-        throw SNchangeNotAllowedException(i,j);
+        snThrow(SNchangeNotAllowedException(i,j));
     }
     return data.at(i-getColumn()-1);  //if you change here, you have to change _get
 }
@@ -90,6 +90,12 @@ class SNgeneric
         virtual T& at(const m_num&,const m_num&) final;
         virtual T get(const m_num&,const m_num&) const final;
 
+        /** 
+         * @brief A copy of the line `l`.
+         *
+         * The operations that do not need a copy should use the views
+         * of `SNmatrix` (`getLineView`).
+         * */
         virtual SNline<T,tp_size> getSNline(m_num l) const;
 
         /** 
@@ -139,7 +145,7 @@ void SNgeneric<T,tp_size>::checkRangeCorectness(const m_num& l,const m_num& c) c
 {
     if (l>tp_size or c>tp_size)
     {
-        throw SNoutOfRangeException(l,c,getSize());
+        snThrow(SNoutOfRangeException(l,c,getSize()));
     }
 }
 
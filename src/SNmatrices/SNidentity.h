@@ -45,7 +45,7 @@ SNidentity<T,tp_size>::SNidentity() { };
 template <class T,unsigned int tp_size>
 T& SNidentity<T,tp_size>::_at(const m_num& i,const m_num& j) 
 {
-        throw SNchangeNotAllowedException(i,j);
+        snThrow(SNchangeNotAllowedException(i,j));
 };
 
 template <class T,unsigned int tp_size>
@@ -0,0 +1,208 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNLAYOUT_H__180214__
+#define __SNLAYOUT_H__180214__
+
+#include <cstddef>
+
+/*
+`SNmatrix`, `SNline` and `SNvector` over-align their storage (see
+`storageAlignment`). Before C++17, `new` and `std::allocator` honour
+that alignment only when the compiler is given `-faligned-new` ;
+without it every heap instance (including the ones in a `std::vector`)
+would be under-aligned.
+*/
+#if __cplusplus < 201703L && !defined(__cpp_aligned_new)
+#error "Before C++17 the SN matrices need -faligned-new (their storage is aligned on 64 bytes)."
+#endif
+
+/*
+The storage layouts of `SNmatrix`.
+
+A layout is a class with two static constexpr functions :
+- `storageSize(n)` : the number of elements to allocate for a matrix n x n,
+- `index(i,j,n)` : the place of the element (i,j) in that storage.
+*/
+
+/** The size of a cache line, in bytes. */
+constexpr std::size_t cache_line_bytes=64;
+
+/**
+* @brief The alignment of an array of `tp_count` elements of type `T`
+* in `SNmatrix`, `SNline` and `SNvector`.
+*
+* An array that spans at least one cache line starts on a cache line :
+* the SIMD loads are aligned and never split between two lines.
+* A smaller array keeps the alignment of `T` (aligning it would only
+* waste memory, for example in a `std::vector` of small vectors).
+*
+* Before C++17 the heap allocations respect this alignment only with
+* `-faligned-new` ; this header refuses to compile without it.
+**/
+template <class T,unsigned int tp_count>
+constexpr std::size_t storageAlignment()
+{
+    return tp_count*sizeof(T)>=cache_line_bytes ? cache_line_bytes : alignof(T);
+}
+
+/**
+* @brief The elements of a column are contiguous : (i,j) is at `j*n+i`.
+*
+* This is the default layout of `SNmatrix`, and the one of the other
+* matrix classes.
+**/
+class ColumnMajor
+{
+    public :
+        static constexpr unsigned int storageSize(unsigned int n)
+        {
+            return n*n;
+        }
+        static constexpr unsigned int index(unsigned int i,unsigned int j,unsigned int n)
+        {
+            return j*n+i;
+        }
+};
+
+/**
+* @brief The elements of a line are contiguous : (i,j) is at `i*n+j`.
+*
+* The line operations of the Gaussian elimination (`eliminateLines`,
+* `swapLines`) then stream contiguous memory.
+**/
+class RowMajor
+{
+    public :
+        static constexpr unsigned int storageSize(unsigned int n)
+        {
+            return n*n;
+        }
+        static constexpr unsigned int index(unsigned int i,unsigned int j,unsigned int n)
+        {
+            return i*n+j;
+        }
+};
+
+/**
+* @brief Column major with a leading dimension : (i,j) is at `j*ld+i`
+* where `ld=leadingDimension(n)` is a multiple of `tp_pad`.
+*
+* With `tp_pad` elements per cache line (8 for double, 16 for float) every
+* column starts on a cache line.
+*
+* When the leading dimension is a power of two, the elements (i,j) and
+* (i,j+1) are a power of two bytes apart and map to the same cache set
+* (and alias modulo 4K for the loads/stores). A large power-of-two leading
+* dimension is then increased by one more cache line.
+**/
+template <unsigned int tp_pad=8>
+class PaddedColumnMajor
+{
+    private :
+        static constexpr bool isPowerOfTwo(unsigned int n)
+        {
+            return n!=0 and (n&(n-1))==0;
+        }
+        static constexpr unsigned int roundUp(unsigned int n)
+        {
+            return (n+tp_pad-1)/tp_pad*tp_pad;
+        }
+    public :
+        static constexpr unsigned int leadingDimension(unsigned int n)
+        {
+            return (roundUp(n)>=8*tp_pad and isPowerOfTwo(roundUp(n))) ? roundUp(n)+tp_pad : roundUp(n);
+        }
+        static constexpr unsigned int storageSize(unsigned int n)
+        {
+            return leadingDimension(n)*n;
+        }
+        static constexpr unsigned int index(unsigned int i,unsigned int j,unsigned int n)
+        {
+            return j*leadingDimension(n)+i;
+        }
+};
+
+/**
+* @brief The matrix is cut in square tiles of `tp_tile x tp_tile` elements,
+* each tile being contiguous (and column major).
+*
+* The tiles are ordered along the Z-order (Morton) curve : the number of
+* the tile \f$ (t_i,t_j) \f$ interleaves the bits of \f$ t_i \f$ and
+* \f$ t_j \f$. Tiles that are close in the matrix are then close in
+* memory, in both directions.
+*
+* The Z-order curve covers a square grid of \f$ 2^k\times 2^k \f$ tiles : the
+* storage is rounded up to that grid (the extra elements are never used).
+**/
+template <unsigned int tp_tile=8>
+class TiledZOrder
+{
+    private :
+        static constexpr unsigned int tiles(unsigned int n)
+        {
+            return (n+tp_tile-1)/tp_tile;
+        }
+        static constexpr unsigned int powerOfTwo(unsigned int t)
+        {
+            unsigned int p=1;
+            while (p<t)
+            {
+                p*=2;
+            }
+            return p;
+        }
+        static constexpr unsigned int morton(unsigned int ti,unsigned int tj)
+        {
+            unsigned int z=0;
+            for (unsigned int bit=0;(ti>>bit)!=0 or (tj>>bit)!=0;++bit)
+            {
+                z|=((ti>>bit)&1u)<<(2*bit+1);
+                z|=((tj>>bit)&1u)<<(2*bit);
+            }
+            return z;
+        }
+    public :
+        static constexpr unsigned int storageSize(unsigned int n)
+        {
+            return powerOfTwo(tiles(n))*powerOfTwo(tiles(n))*tp_tile*tp_tile;
+        }
+        static constexpr unsigned int index(unsigned int i,unsigned int j,unsigned int)
+        {
+            return morton(i/tp_tile,j/tp_tile)*tp_tile*tp_tile+(j%tp_tile)*tp_tile+i%tp_tile;
+        }
+};
+
+/**
+* @brief A plain array of `tp_count` elements.
+*
+* Before C++17 the non-const `operator[]` of `std::array` is not `constexpr` :
+* the `constexpr` functions fill this one and the constructors copy it
+* in their `std::array`.
+**/
+template <class T,std::size_t tp_count>
+struct SNconstexprArray
+{
+    T values[tp_count];
+};
+
+// forward definition
+template <class T,unsigned int tp_size,class Layout=ColumnMajor>
+class SNmatrix;
+
+#endif
@@ -23,10 +23,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include<array>
 
 #include "m_num.h"
-
-
-template <class T,unsigned int tp_size>
-class SNmatrix;
+#include "SNlayout.h"
+#include "SNview.h"
 
 // THE CLASS HEADER -----------------------------------------
 
@@ -35,13 +33,16 @@ class SNmatrix;
 *
 * An element contains
 * - its line number
+*
+* A `SNline` is a copy of the line. The operations on the lines of a
+* matrix that do not need a copy go through `SNlineView` (SNview.h).
 */
 template <class T,unsigned int tp_size>
 class SNline
 { 
     friend class GaussTest;
     private :
-        std::array<T,tp_size> data;
+        alignas(storageAlignment<T,tp_size>()) std::array<T,tp_size> data;
         unsigned int line;
 
         explicit SNline(const std::array<T,tp_size>&);  // for testing purpose only
@@ -54,6 +55,10 @@ class SNline
         SNline();
         SNline(unsigned int line,SNmatrix<T,tp_size>& snmatrix);
 
+        /** @brief Copy the elements seen by the view. */
+        template <class U,class Layout>
+        explicit SNline(const SNlineView<U,tp_size,Layout>& view);
+
         template <class U,class V,unsigned int s>
         friend bool operator==(const SNline<U,s>&,const SNline<V,s>&);
         template <class U,unsigned int s>
@@ -69,6 +74,10 @@ class SNline
         /** Return by value the value of the ith element on the line */
         T get(const unsigned int i) const;
 
+        /** Unchecked access to the elements, for the inner loops. */
+        T& operator[](m_num i);
+        T operator[](m_num i) const;
+
         /**   return the number of the first non-zero element in the line.*/
         unsigned int firstNonZeroColumn() const;
 
@@ -91,11 +100,17 @@ SNline<T,tp_size>::SNline() :
 
 template <class T,unsigned int tp_size>
 SNline<T,tp_size>::SNline(unsigned int l,SNmatrix<T,tp_size>& snm) : 
-    line(l)
+    SNline(snm.getLineView(l))
+{}
+
+template <class T,unsigned int tp_size>
+template <class U,class Layout>
+SNline<T,tp_size>::SNline(const SNlineView<U,tp_size,Layout>& view) : 
+    line(view.getLine())
 { 
     for (m_num c=0;c<tp_size;++c)
     {
-        data.at(c)=snm.get(l,c);
+        data[c]=view[c];
     }
 }
 
@@ -112,15 +127,14 @@ bool operator==(const SNline<U,s>& A,const SNline<V,s>& B)
 }
 
 // multiplication by a scalar.
-// This is not in-place replacement.
+// This is not in-place replacement : the result is the only copy.
 template <class U,unsigned int s>
 SNline<U,s> operator* (U m, const SNline<U,s>& v)
 {
-    std::array<U,s> arr;
-    SNline<U,s> ans(arr);
+    SNline<U,s> ans(v);
     for (unsigned int c=0;c<s;c++)
     {
-        ans.at(c)=m*v.get(c);
+        ans.data[c]*=m;
     }
     return ans;
 }
@@ -157,6 +171,18 @@ T SNline<T,tp_size>::get(const unsigned int i) const
     return data.at(i);
 };
 
+template <class T,unsigned int tp_size>
+T& SNline<T,tp_size>::operator[](m_num i)
+{
+    return data[i];
+}
+
+template <class T,unsigned int tp_size>
+T SNline<T,tp_size>::operator[](m_num i) const
+{
+    return data[i];
+}
+
 // OTHER FUNCTIONALITIES -------------------------------------------
 
 
@@ -169,7 +195,7 @@ unsigned int SNline<T,tp_size>::firstNonZeroColumn() const
 {
     for (unsigned int col=0;col<tp_size;col++)
     {
-        if (get(col)!=0)
+        if (data[col]!=0)
         {
             return col;
         }
@@ -183,11 +209,11 @@ void SNline<T,tp_size>::makeUnit()
     unsigned int col=firstNonZeroColumn();
     if (col!=tp_size+1)
     {
-        const T m = get(col);
-        at(col)=1;      // the first one is by hand 1 (because we know it).
+        const T m = data[col];
+        data[col]=1;      // the first one is by hand 1 (because we know it).
         for (unsigned int c=col+1;c<tp_size;c++)
         {
-            at(c)=get(c)/m;
+            data[c]/=m;
         }
     }
 }
@@ -52,6 +52,12 @@ class SNlowerTriangular : public SNgeneric<T,tp_size>
     public :
         std::array<T,tp_size*tp_size> _get_other_data(const SNmatrix<T,tp_size>&) const;
 
+        /** 
+         * @brief Unchecked access to the element (i,j), which has to be in the
+         * lower triangle (included the diagonal). For the unrolled kernels (SNunrolled.h).
+         * */
+        T operator()(m_num i,m_num j) const;
+
         /** 
          * @brief Construct a lower triangular matrix with non initialized entries.
          * */
@@ -170,6 +176,12 @@ void SNlowerTriangular<T,tp_size>::swap(SNlowerTriangular<T,tp_size>& other)
     std::swap(data,other.data);
 }
 
+template <class T,unsigned int tp_size>
+T SNlowerTriangular<T,tp_size>::operator()(m_num i,m_num j) const
+{
+    return data[j*tp_size+i];
+}
+
 // _GET AND _AT METHODS ---------------------------------------
 
 template <class T,unsigned int tp_size>
@@ -188,7 +200,7 @@ T& SNlowerTriangular<T,tp_size>::_at(const m_num& l,const m_num& c)
 {
     if (l<c)
     {
-        throw SNchangeNotAllowedException(l,c);
+        snThrow(SNchangeNotAllowedException(l,c));
     }
     return data.at(c*tp_size+l);
 }
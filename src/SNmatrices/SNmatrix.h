@@ -22,19 +22,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <array>
 #include <iostream>
 #include <cmath>
+#include <utility>
 
 #include "SNgeneric.h"
 #include "SNelement.h"
+#include "SNlayout.h"
 #include "SNline.h"
+#include "SNview.h"
+#include "SNblockView.h"
+#include "SNunrolled.h"
 #include "SNgaussian.h"
 #include "SNupperTriangular.h"
 #include "Mpermutation.h"
+#include "MpivotSequence.h"
 #include "SNpermutation.h"
 #include "MelementaryPermutation.h"
 #include "MathUtilities.h"
 #include "operators/SNoperators.h"
 #include "operators/multiplications.h"
 #include "../SNvector.h"
+#include "../ThreadPool.h"
 #include "../exceptions/SNexceptions.cpp"
 
 #include "../Utilities.h"
@@ -43,6 +50,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // forward definition
 template <class T,unsigned int tp_size>
 class SNplu;
+template <class T,unsigned int tp_size>
+class SNindirectPLU;
+class SNarena;
 
 
 /**
@@ -52,7 +62,7 @@ class SNplu;
 * (SN=Square Numerical).
 *
 * ```
-* template <class T,unsigned int tp_size>
+* template <class T,unsigned int tp_size,class Layout=ColumnMajor>
 * class SNmatrix
 * ```
 *
@@ -60,6 +70,10 @@ class SNplu;
 *   to be a numeric type in the sense that it has to accept comparison, 
 *   absolute value (from cmath) and other operations like that.
 * - `tp_size` is the size of the matrix.
+* - `Layout` is the way the elements are stored in memory : `ColumnMajor`,
+*   `RowMajor`, `PaddedColumnMajor<pad>` or `TiledZOrder<tile>` (see SNlayout.h). The operators and
+*   the other matrix classes are written for `ColumnMajor`; a matrix with
+*   another layout is seen by them as a `SNgeneric`.
 *
 * NOTE : if you want the identity matrix, there is the `SNidentity` class.
 *
@@ -75,13 +89,23 @@ class SNplu;
 * ```
 * Notice that the elements are numbered from `0` to `tp_size-1`. Not from `1`.
 *
+* A matrix can also be a `constexpr` constant, given its elements in
+* column major order :
+* ```
+* constexpr SNmatrix<int,2> sn(std::array<int,4>{{1,3,2,4}});
+* static_assert(sn(0,1)==2,"");
+* ```
+* The virtual `get` and `at` cannot be used in a constant expression
+* (before C++20) : `operator()` is the `constexpr` access.
+*
 **/
-template <class T,unsigned int tp_size>
+template <class T,unsigned int tp_size,class Layout>
 class SNmatrix  : public SNgeneric<T,tp_size>
 {
 
     friend class SNmatrixTest;
     friend class GaussTest;
+    friend class UnrolledTest;
 
     template <class U,unsigned int s,class V,unsigned int t>
     friend bool operator==(const SNmatrix<U,s>&,const SNmatrix<V,t>&);
@@ -93,9 +117,16 @@ class SNmatrix  : public SNgeneric<T,tp_size>
 
 
     private:
-        std::array<T,tp_size*tp_size> data;
+        alignas(storageAlignment<T,Layout::storageSize(tp_size)>()) std::array<T,Layout::storageSize(tp_size)> data;
         unsigned int size=tp_size;
 
+        typedef SNconstexprArray<T,Layout::storageSize(tp_size)> Storage;
+
+        /** The storage of the matrix whose elements are `values` (column major). */
+        static constexpr Storage toStorage(const std::array<T,tp_size*tp_size>& values);
+        template <std::size_t... Is>
+        constexpr SNmatrix(const Storage& storage,std::index_sequence<Is...>);
+
         /**  the larger element on column 'col' under (or on) the line 'f_line'.*/
         SNelement<T,tp_size> getLargerUnder(m_num f_line, m_num col) const;
 
@@ -105,7 +136,24 @@ class SNmatrix  : public SNgeneric<T,tp_size>
         //  where 'k' is the first element of L_i and 'm' is the pivot.
         //  The function 'lineMinusLine' serves to not compute L_1/m
         //  as many times as the number of substitutions to do.
-        void lineMinusLine(m_num line,SNline<T,tp_size> v);
+        //  The version with a view subtracts a line of a matrix without copy.
+        void lineMinusLine(m_num line,const SNline<T,tp_size>& v);
+        template <class U>
+        void lineMinusLine(m_num line,const SNlineView<U,tp_size,Layout>& v);
+
+        // Use the line 'c' (the pivot line) to eliminate the column 'c'
+        // on the lines 'first' to 'last-1'.
+        void eliminateLines(m_num c,m_num first,m_num last);
+
+        // The PLU decomposition itself. The function 'trailing_update(mU,c)'
+        // has to eliminate the column 'c' on the lines under the diagonal of 'mU'.
+        // When 'arena' is not null, the factors are stored there.
+        template <class F>
+        SNplu<T,tp_size> decomposePLU(F trailing_update,SNarena* arena=nullptr) const;
+
+        // 'getPLU()' for the small sizes (fully unrolled) and the other ones.
+        SNplu<T,tp_size> getPLU(std::true_type) const;
+        SNplu<T,tp_size> getPLU(std::false_type) const;
 
 
         // return the larger element (in absolute value) on the given column
@@ -128,10 +176,16 @@ class SNmatrix  : public SNgeneric<T,tp_size>
         void _set_from(const SNgeneric<T,tp_size>&);
         void set_identity();
     public:
-        SNmatrix();
+        constexpr SNmatrix();
 
-        //cppcheck-suppress noExplicitConstructor
-        SNmatrix(const SNmatrix<T,tp_size>&);
+        constexpr SNmatrix(const SNmatrix<T,tp_size,Layout>&)=default;
+        SNmatrix& operator=(const SNmatrix<T,tp_size,Layout>&)=default;
+
+        /** 
+         * Create the matrix whose element (i,j) is `values[j*tp_size+i]`
+         * (column major, whatever the layout).
+         * */
+        constexpr explicit SNmatrix(const std::array<T,tp_size*tp_size>& values);
 
         /**
          * Construct a SNmatrix as copy of a generic matrix.
@@ -146,6 +200,14 @@ class SNmatrix  : public SNgeneric<T,tp_size>
         explicit SNmatrix(const T& x);
 
 
+        /** 
+         * @brief Unchecked access to the element (i,j), usable in a constant
+         * expression.
+         * */
+        constexpr T operator()(m_num i,m_num j) const;
+        /** @brief Unchecked access to the element (i,j) by reference. */
+        T& operator()(m_num i,m_num j);
+
         // return the max of the absolute values of all the matrix elements
         T max_norm() const;
 
@@ -158,24 +220,107 @@ class SNmatrix  : public SNgeneric<T,tp_size>
          * */ 
         void swapLines(m_num l1,m_num l2);
 
+        /** @brief A copy of the line `l`, read through `getLineView`. */
+        SNline<T,tp_size> getSNline(m_num l) const override;
+
+        /**
+         * @brief A view on the line `l` : reading and writing through the
+         * view acts on the matrix, without copy (see SNview.h).
+         * */
+        SNlineView<T,tp_size,Layout> getLineView(m_num l);
+        SNlineView<const T,tp_size,Layout> getLineView(m_num l) const;
+
+        /** @brief A view on the column `c` (see `getLineView`). */
+        SNcolumnView<T,tp_size,Layout> getColumnView(m_num c);
+        SNcolumnView<const T,tp_size,Layout> getColumnView(m_num c) const;
+
+        /**
+         * @brief A view on the block of `lines` lines and `columns` columns
+         * whose upper left element is (first_line,first_column).
+         *
+         * See `SNblockView` for the in-place block operations.
+         * */
+        SNblockView<T,tp_size,Layout> getBlockView(m_num first_line,m_num first_column,m_num lines,m_num columns);
+        SNblockView<const T,tp_size,Layout> getBlockView(m_num first_line,m_num first_column,m_num lines,m_num columns) const;
+
 
         /** 
          * return the PLU decomposition as a `SNplu` object.
          */ 
         SNplu<T,tp_size> getPLU() const;
 
+        /** 
+         * @brief return the PLU decomposition, whose factors are stored in
+         * `arena` instead of the heap.
+         *
+         * The decomposition must be destroyed before `arena.reset()`.
+         * See `SNarena` (include "SNarena.h" to use it).
+         */ 
+        SNplu<T,tp_size> getPLU(SNarena& arena) const;
+
+        /** 
+         * @brief return the PLU decomposition, using the threads of `pool`.
+         *
+         * At each column, the lines under the diagonal are updated 
+         * independently; these updates are shared between the threads of 
+         * the pool. The pivot search and the construction of L remain serial.
+         *
+         * The synchronization cost is not worth for small matrices. When
+         * the matrix size is smaller than `serial_threshold`, this is the 
+         * same as `getPLU()`. For the same reason, the last columns (when less
+         * than `serial_threshold` lines remain to be updated) are done
+         * by the calling thread only.
+         *
+         * The result is exactly the one of `getPLU()` : each line gets the same
+         * operations in the same order.
+         */ 
+        SNplu<T,tp_size> getPLU(ThreadPool& pool,unsigned int serial_threshold=64) const;
+
+        /** 
+         * @brief return the PLU decomposition computed without swapping
+         * the lines : the pivoting only swaps indices.
+         *
+         * See `SNindirectPLU` (include "SNindirectPLU.h" to use it).
+         */ 
+        SNindirectPLU<T,tp_size> getIndirectPLU() const;
+
 };
 
 // CONSTRUCTORS  -------------------------------------------
 
-template <class T,unsigned int tp_size>
-SNmatrix<T,tp_size>::SNmatrix(): data() { };
+template <class T,unsigned int tp_size,class Layout>
+constexpr SNmatrix<T,tp_size,Layout>::SNmatrix(): data() { };
 
-template <class T,unsigned int tp_size>
-SNmatrix<T,tp_size>::SNmatrix(const SNmatrix<T,tp_size>& snm) : data(snm.data)  {};
+template <class T,unsigned int tp_size,class Layout>
+constexpr SNmatrix<T,tp_size,Layout>::SNmatrix(const std::array<T,tp_size*tp_size>& values):
+    SNmatrix(toStorage(values),std::make_index_sequence<Layout::storageSize(tp_size)>())
+{}
 
-template <class T,unsigned int tp_size>
-SNmatrix<T,tp_size>::SNmatrix(const T& x): 
+template <class T,unsigned int tp_size,class Layout>
+template <std::size_t... Is>
+constexpr SNmatrix<T,tp_size,Layout>::SNmatrix(const Storage& storage,std::index_sequence<Is...>):
+    data{{storage.values[Is]...}}
+{}
+
+template <class T,unsigned int tp_size,class Layout>
+constexpr typename SNmatrix<T,tp_size,Layout>::Storage SNmatrix<T,tp_size,Layout>::toStorage(const std::array<T,tp_size*tp_size>& values)
+
+    // The padding of the layout (if any) is zero.
+
+{
+    Storage storage{};
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            storage.values[Layout::index(i,j,tp_size)]=values[j*tp_size+i];
+        }
+    }
+    return storage;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNmatrix<T,tp_size,Layout>::SNmatrix(const T& x): 
     data{}
 {
 
@@ -185,16 +330,17 @@ SNmatrix<T,tp_size>::SNmatrix(const T& x):
     }
 };
 
-template <class T,unsigned int tp_size>
-SNmatrix<T,tp_size>::SNmatrix(const SNgeneric<T,tp_size>& A)
+template <class T,unsigned int tp_size,class Layout>
+SNmatrix<T,tp_size,Layout>::SNmatrix(const SNgeneric<T,tp_size>& A):
+    data()      // the padding of the layout has to be zero too.
 {
     this->_set_from(A);
 }
 
 //  SOME ILLEGITIMATE(?) WAYS TO SET THE VALUES OF A MATRIX -----------------
 
-template <class T,unsigned int tp_size>
-void SNmatrix<T,tp_size>::_set_from(const SNgeneric<T,tp_size>& A)
+template <class T,unsigned int tp_size,class Layout>
+void SNmatrix<T,tp_size,Layout>::_set_from(const SNgeneric<T,tp_size>& A)
 {
     for (m_num i=0;i<tp_size;++i)
     {
@@ -204,8 +350,8 @@ void SNmatrix<T,tp_size>::_set_from(const SNgeneric<T,tp_size>& A)
         }
     }
 }
-template <class T,unsigned int tp_size>
-void SNmatrix<T,tp_size>::set_identity()
+template <class T,unsigned int tp_size,class Layout>
+void SNmatrix<T,tp_size,Layout>::set_identity()
 {
     for (m_num i=0;i<tp_size;++i)
     {
@@ -220,25 +366,37 @@ void SNmatrix<T,tp_size>::set_identity()
 // GETTER METHODS  -------------------------------------------
 
 
-template <class T,unsigned int tp_size>
-SNelement<T,tp_size> SNmatrix<T,tp_size>::getElement(m_num line, m_num col) const
+template <class T,unsigned int tp_size,class Layout>
+SNelement<T,tp_size> SNmatrix<T,tp_size,Layout>::getElement(m_num line, m_num col) const
 {
     return SNelement<T,tp_size>(line,col,this->get(line,col));
 }
 
 
+template <class T,unsigned int tp_size,class Layout>
+constexpr T SNmatrix<T,tp_size,Layout>::operator()(m_num i,m_num j) const
+{
+    return data[Layout::index(i,j,tp_size)];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNmatrix<T,tp_size,Layout>::operator()(m_num i,m_num j)
+{
+    return data[Layout::index(i,j,tp_size)];
+}
+
 // _GET AND _AT METHODS ---------------------------
 
-template <class T,unsigned int tp_size>
-T& SNmatrix<T,tp_size>::_at(const m_num& i,const m_num& j) 
+template <class T,unsigned int tp_size,class Layout>
+T& SNmatrix<T,tp_size,Layout>::_at(const m_num& i,const m_num& j) 
 {
-    return data.at(j*tp_size+i);
+    return data.at(Layout::index(i,j,tp_size));
 };
 
-template <class T,unsigned int tp_size>
-T SNmatrix<T,tp_size>::_get(const m_num& i,const m_num& j) const
+template <class T,unsigned int tp_size,class Layout>
+T SNmatrix<T,tp_size,Layout>::_get(const m_num& i,const m_num& j) const
 {
-    return data.at(j*tp_size+i);
+    return data.at(Layout::index(i,j,tp_size));
 };
 
 
@@ -246,8 +404,8 @@ T SNmatrix<T,tp_size>::_get(const m_num& i,const m_num& j) const
 
 
 
-template <class T,unsigned int tp_size>
-T SNmatrix<T,tp_size>::max_norm() const
+template <class T,unsigned int tp_size,class Layout>
+T SNmatrix<T,tp_size,Layout>::max_norm() const
 {
     T m(0);
     for (T v:data)
@@ -261,11 +419,11 @@ T SNmatrix<T,tp_size>::max_norm() const
     return m;
 }
 
-template <class T,unsigned int tp_size>
-SNelement<T,tp_size> SNmatrix<T,tp_size>::getLargerUnder(m_num f_line, m_num col) const
+template <class T,unsigned int tp_size,class Layout>
+SNelement<T,tp_size> SNmatrix<T,tp_size,Layout>::getLargerUnder(m_num f_line, m_num col) const
 {
     T max_val=0;
-    m_num max_line=0;
+    m_num max_line=f_line;
 
     for (m_num line=f_line;line<tp_size;++line)
     {
@@ -278,52 +436,118 @@ SNelement<T,tp_size> SNmatrix<T,tp_size>::getLargerUnder(m_num f_line, m_num col
     return getElement(max_line,col);
 }
 
-template <class T,unsigned int tp_size>
-SNelement<T,tp_size> SNmatrix<T,tp_size>::getLargerOnColumn(m_num col) const
+template <class T,unsigned int tp_size,class Layout>
+SNelement<T,tp_size> SNmatrix<T,tp_size,Layout>::getLargerOnColumn(m_num col) const
 {
     return getLargerUnder(0,col);
 }
 
-template <class T,unsigned int tp_size>
-SNelement<T,tp_size> SNmatrix<T,tp_size>::getLargerUnderDiagonal(m_num col)  const
+template <class T,unsigned int tp_size,class Layout>
+SNelement<T,tp_size> SNmatrix<T,tp_size,Layout>::getLargerUnderDiagonal(m_num col)  const
 {
     return getLargerUnder(col,col);
 }
 
-template <class T,unsigned int tp_size>
-void SNmatrix<T,tp_size>::swapLines(m_num l1, m_num l2)
+template <class T,unsigned int tp_size,class Layout>
+void SNmatrix<T,tp_size,Layout>::swapLines(m_num l1, m_num l2)
 {
-    if (l1!=l2)
-    {
-        for (m_num col=0;col<tp_size;++col)
-        {
-            T tmp = this->get(l1,col);
-            this->at(l1,col)=this->get(l2,col);
-            this->at(l2,col)=tmp;
-        }
-    }
+    getLineView(l1).swap(getLineView(l2));
 }
 
 
-template <class T,unsigned int tp_size>
-void SNmatrix<T,tp_size>::lineMinusLine(m_num line,SNline<T,tp_size> v)
+template <class T,unsigned int tp_size,class Layout>
+SNlineView<T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getLineView(m_num l)
 {
+    return SNlineView<T,tp_size,Layout>(data.data(),l);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNlineView<const T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getLineView(m_num l) const
+{
+    return SNlineView<const T,tp_size,Layout>(data.data(),l);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNcolumnView<T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getColumnView(m_num c)
+{
+    return SNcolumnView<T,tp_size,Layout>(data.data(),c);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNcolumnView<const T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getColumnView(m_num c) const
+{
+    return SNcolumnView<const T,tp_size,Layout>(data.data(),c);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNblockView<T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getBlockView(m_num first_line,m_num first_column,m_num lines,m_num columns)
+{
+    return SNblockView<T,tp_size,Layout>(data.data(),first_line,first_column,lines,columns);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNblockView<const T,tp_size,Layout> SNmatrix<T,tp_size,Layout>::getBlockView(m_num first_line,m_num first_column,m_num lines,m_num columns) const
+{
+    return SNblockView<const T,tp_size,Layout>(data.data(),first_line,first_column,lines,columns);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNline<T,tp_size> SNmatrix<T,tp_size,Layout>::getSNline(m_num l) const
+{
+    return SNline<T,tp_size>(getLineView(l));
+}
+
+template <class T,unsigned int tp_size,class Layout>
+void SNmatrix<T,tp_size,Layout>::lineMinusLine(m_num line,const SNline<T,tp_size>& v)
+{
+    const auto view=getLineView(line);
     for (m_num c=0;c<tp_size;++c)
     {
-        this->at(line,c)=this->get(line,c)-v.get(c);
+        view[c]-=v[c];
     }
 }
 
-template <class T,unsigned int tp_size>
-SNline<T,tp_size> SNmatrix<T,tp_size>::gaussEliminationLine(m_num line)
+template <class T,unsigned int tp_size,class Layout>
+template <class U>
+void SNmatrix<T,tp_size,Layout>::lineMinusLine(m_num line,const SNlineView<U,tp_size,Layout>& v)
 {
-    SNline<T,tp_size> l=this->getSNline(line);
+    getLineView(line).subtractScaled(1,v);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNline<T,tp_size> SNmatrix<T,tp_size,Layout>::gaussEliminationLine(m_num line)
+
+    // The returned line is the only copy.
+
+{
+    SNline<T,tp_size> l(getLineView(line));
     l.makeUnit();
     return l;
 }
 
-template <class T,unsigned int tp_size>
-SNplu<T,tp_size> SNmatrix<T,tp_size>::getPLU() const
+template <class T,unsigned int tp_size,class Layout>
+void SNmatrix<T,tp_size,Layout>::eliminateLines(m_num c,m_num first,m_num last)
+
+    // L_l -> L_l - (m/p)*L_c where 'm' is the element (l,c) and 'p' the pivot.
+    // The 'c' first elements of the pivot line are 0 and the element (l,c)
+    // becomes exactly 0 : the subtraction starts at the column 'c+1'.
+    // Everything is done through views : no line is copied.
+
+{
+    const auto pivot_line=getLineView(c);
+    const T pivot=pivot_line[c];
+    for (m_num l=first;l<last;++l)
+    {
+        const auto line=getLineView(l);
+        const T m=line[c]/pivot;
+        line[c]=0;
+        line.subtractScaled(m,pivot_line,c+1);
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class F>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::decomposePLU(F trailing_update,SNarena* arena) const
 
     // for each column :
     // - get the larger entry under the diagonal
@@ -339,9 +563,9 @@ SNplu<T,tp_size> SNmatrix<T,tp_size>::getPLU() const
 
     // mL will progressively become L
     // mU will progressively become U
-    Mpermutation<tp_size> mP; // identity
+    MpivotSequence<tp_size> pivots; // identity
     SNmultiGaussian<T,tp_size> mL(1);   // identity
-    SNmatrix<T,tp_size> mU=*this;  
+    SNmatrix<T,tp_size,Layout> mU=*this;  
 
     for (m_num c=0;c<tp_size;++c)
     {
@@ -351,8 +575,7 @@ SNplu<T,tp_size> SNmatrix<T,tp_size>::getPLU() const
         {
 
             // We swap the line 'c' with max_el.line
-            MelementaryPermutation<tp_size> el_perm(c,max_el.line);
-            mP=mP*el_perm; 
+            pivots.setPivot(c,max_el.line);
             mU.swapLines(c,max_el.line);
 
             auto G=mU.getGaussian(c);
@@ -367,22 +590,106 @@ SNplu<T,tp_size> SNmatrix<T,tp_size>::getPLU() const
             {
                 mL=G.inverse();
             }
-            auto killing_line=mU.gaussEliminationLine(c);
-            for (m_num l=c+1;l<tp_size;++l)
-            {
-                T m = mU.get(l,c);  // the value to be eliminated
-
-                // TODO : this is not optimal because
-                // we already know the first 'c' differences are 0.
-                mU.lineMinusLine(l,m*killing_line);
-            }
+            trailing_update(mU,c);
         }
     }
     // at this point, the matrix mU should be the correct one.
     // so we dare to use the *explicit* conversion from SNmatrix
     // to SNupperTriangular.
-    SNplu<T,tp_size> plu(mP,mL,SNupperTriangular<T,tp_size>(mU));
-    return plu;
+    if (arena)
+    {
+        return SNplu<T,tp_size>(pivots.toMpermutation(),mL,SNupperTriangular<T,tp_size>(mU),*arena);
+    }
+    return SNplu<T,tp_size>(pivots.toMpermutation(),mL,SNupperTriangular<T,tp_size>(mU));
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::getPLU() const
+{
+    return getPLU(SNuseUnrolled<tp_size>());
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::getPLU(std::false_type) const
+{
+    return decomposePLU([](SNmatrix<T,tp_size,Layout>& mU,m_num c)
+            {
+                mU.eliminateLines(c,c+1,tp_size);
+            });
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::getPLU(std::true_type) const
+
+    // The elimination is done on a local array, without any
+    // intermediate matrix object; the factors are built at the end.
+
+{
+    T a[tp_size*tp_size];
+    unsigned int rows[tp_size];
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            a[j*tp_size+i]=(*this)(i,j);
+        }
+    }
+    unrolledFactorize<tp_size>(a,rows);
+
+    SNlowerTriangular<T,tp_size> mL(1);
+    SNupperTriangular<T,tp_size> mU;
+    std::array<unsigned int,tp_size> image;
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        image[i]=rows[i];
+        for (unsigned int j=0;j<i;++j)
+        {
+            mL.at(i,j)=a[j*tp_size+i];
+        }
+        for (unsigned int j=i;j<tp_size;++j)
+        {
+            mU.at(i,j)=a[j*tp_size+i];
+        }
+    }
+    return SNplu<T,tp_size>(Mpermutation<tp_size>(image),mL,mU);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::getPLU(SNarena& arena) const
+{
+    return decomposePLU([](SNmatrix<T,tp_size,Layout>& mU,m_num c)
+            {
+                mU.eliminateLines(c,c+1,tp_size);
+            },&arena);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNplu<T,tp_size> SNmatrix<T,tp_size,Layout>::getPLU(ThreadPool& pool,unsigned int serial_threshold) const
+{
+    if (tp_size<serial_threshold)
+    {
+        return getPLU();
+    }
+    return decomposePLU([&pool,serial_threshold](SNmatrix<T,tp_size,Layout>& mU,m_num c)
+            {
+                if (tp_size-c-1<serial_threshold)
+                {
+                    mU.eliminateLines(c,c+1,tp_size);
+                    return;
+                }
+                // The lines are independent : each chunk writes its own lines
+                // and only reads the pivot line.
+                pool.parallelFor(c+1,tp_size,[&mU,c](unsigned int first,unsigned int last)
+                    {
+                        mU.eliminateLines(c,first,last);
+                    });
+            });
+}
+
+template <class T,unsigned int tp_size,class Layout>
+SNindirectPLU<T,tp_size> SNmatrix<T,tp_size,Layout>::getIndirectPLU() const
+{
+    return SNindirectPLU<T,tp_size>(*this);
 }
 
 #endif
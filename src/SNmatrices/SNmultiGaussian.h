@@ -95,8 +95,7 @@ class SNmultiGaussian : public SNgeneric<T,tp_size>
          * `A*=B` does
          * - `A=A*B` if A is multigaussian with last non trivial column 
          *   \f$ l_l \f$ and if B is gaussian for the column \f$ l_c+1 \f$.
-         * - throw `IncompatibleMatrixSizeException` exception if the size are
-         *   not the same.
+         * - does not compile if the size are not the same.
          * - throw `ProbablyNotWhatYouWantException` if the requirements about
          *   the column are not fulfilled.
          * */
@@ -172,7 +171,7 @@ SNmultiGaussian<T,tp_size>::SNmultiGaussian(const T& x):
 {
     if (x!=1)
     {
-        throw SNchangeNotAllowedException(0,0,"The one parameter constructor of 'SNmultiGaussian' only works with 1 as agrument, because the other diagonal matrices are not multigaussian.");
+        snThrow(SNchangeNotAllowedException(0,0,"The one parameter constructor of 'SNmultiGaussian' only works with 1 as agrument, because the other diagonal matrices are not multigaussian."));
     }
 }
 
@@ -239,7 +238,7 @@ void SNmultiGaussian<T,tp_size>::setLastColumn(const m_num& lc)
     if (lc>tp_size-1)   // makes no sense to have a gaussian 
                         // behaviour on the last line.
     {
-        throw OutOfRangeColumnNumber("The specified column number is larger than the size of the matrix.");
+        snThrow(OutOfRangeColumnNumber("The specified column number is larger than the size of the matrix."));
     }
     data_last_column=lc;
 }
@@ -266,7 +265,7 @@ void SNmultiGaussian<T,tp_size>::operator *=(const SNgaussian<T,tp_size>& other)
     checkSizeCompatibility(*this,other);
     if (other.getColumn()!=data_last_column+1)
     {
-        throw ProbablyNotWhatYouWantException("You are trying to multiply a multi-Gaussian matrix by a gaussian matrix whose column is not the next one. This is mathematically possible, but probably not what you want. However; this situation is not yet implemented.");
+        snThrow(ProbablyNotWhatYouWantException("You are trying to multiply a multi-Gaussian matrix by a gaussian matrix whose column is not the next one. This is mathematically possible, but probably not what you want. However; this situation is not yet implemented."));
     }
     ++data_last_column;
     for (m_num l=other.getColumn()+1;l<tp_size;++l)
@@ -305,7 +304,7 @@ void SNmultiGaussian<T,tp_size>::swapLines(const m_num& i,const m_num& j)
 {
     if (i<=getLastColumn() or j<=getLastColumn())
     {
-        throw ProbablyNotWhatYouWantException("You are trying to swap the lines "+std::to_string(i)+" and "+std::to_string(j)+" while the last non trivial column is "+std::to_string(getLastColumn()) );
+        snThrow(ProbablyNotWhatYouWantException("You are trying to swap the lines "+std::to_string(i)+" and "+std::to_string(j)+" while the last non trivial column is "+std::to_string(getLastColumn()) ));
     }
     for (m_num col=0;col<=getLastColumn();++col)
     {
@@ -364,12 +363,12 @@ T& SNmultiGaussian<T,tp_size>::_at(const m_num& i, const m_num& j)
 {
     if (data_last_column==tp_size+1)
     {
-        throw NotInitializedMemberException("You are trying to populate a 'SNmultiGaussian' before to initialize the member 'data_last_column'. Use setLastColumn().");
+        snThrow(NotInitializedMemberException("You are trying to populate a 'SNmultiGaussian' before to initialize the member 'data_last_column'. Use setLastColumn()."));
     }
     SpecialValue<T> sv=checkForSpecialElements(i,j);
     if (sv.special)
     {
-        throw SNchangeNotAllowedException(i,j);
+        snThrow(SNchangeNotAllowedException(i,j));
     }
     return data_L.at(i,j);  //if you change here, you have to change _get
 }
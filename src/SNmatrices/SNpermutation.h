@@ -93,7 +93,7 @@ std::ostream& operator<<(std::ostream& stream, SNpermutation<T,s> perm)
 template <class T,unsigned int tp_size>
 T& SNpermutation<T,tp_size>::_at(const m_num& i,const m_num& j)
 {
-    throw SNchangeNotAllowedException(i,j);
+    snThrow(SNchangeNotAllowedException(i,j));
 };
 
 template <class T,unsigned int tp_size>
@@ -0,0 +1,306 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNRECTANGULAR_H__154320__
+#define __SNRECTANGULAR_H__154320__
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "m_num.h"
+#include "SNlayout.h"
+#include "SNgeneric.h"
+#include "SNmatrix.h"
+#include "../SNvector.h"
+#include "../exceptions/SNexceptions.cpp"
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A numerical matrix with `tp_lines` lines and `tp_columns` columns.
+*
+* This is the non-square companion of `SNmatrix`, for the panels, the
+* Krylov bases or the restriction and prolongation operators : a
+* \f$ n\times k \f$ matrix stores \f$ nk \f$ elements instead of
+* the \f$ n^2 \f$ of a padded square matrix.
+*
+* The storage is column major. Since the dimensions are template parameters,
+* the products (with each other, with the square matrices and with
+* `SNvector`) are checked at compile time :
+* ```
+* SNrectangular<double,8,3> V;
+* SNrectangular<double,3,8> W;
+* SNmatrix<double,8> A;
+* auto H=W*A*V;        // SNrectangular<double,3,3>
+* auto X=V*A;          // does not compile : 8x3 times 8x8
+* ```
+* As for the other products of the library, the type of the elements of
+* the result is the one of the left operand.
+*
+* `SNrectangular` does not derive from `SNgeneric`, which is square.
+**/
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+class SNrectangular
+{
+    private :
+        alignas(storageAlignment<T,tp_lines*tp_columns>()) std::array<T,tp_lines*tp_columns> data;
+
+        template <std::size_t... Is>
+        constexpr SNrectangular(const std::array<T,tp_lines*tp_columns>& values,std::index_sequence<Is...>);
+    public :
+        /** @brief The zero matrix. */
+        constexpr SNrectangular();
+
+        /** 
+         * Create the matrix whose element (i,j) is `values[j*tp_lines+i]`
+         * (column major).
+         * */
+        constexpr explicit SNrectangular(const std::array<T,tp_lines*tp_columns>& values);
+
+        /** @brief Copy of a square matrix (when `tp_lines==tp_columns`). */
+        template <class U,unsigned int s>
+        explicit SNrectangular(const SNgeneric<U,s>& A);
+
+        static constexpr unsigned int getLines();
+        static constexpr unsigned int getColumns();
+
+        /** Unchecked access to the element (i,j), for the inner loops. */
+        constexpr T operator()(m_num i,m_num j) const;
+        T& operator()(m_num i,m_num j);
+
+        /** throw `RectangularOutOfRangeException` if (i,j) is out of range */
+        T get(m_num i,m_num j) const;
+        T& at(m_num i,m_num j);
+
+        /** @brief Return the transposed matrix, \f$ tp\_columns\times tp\_lines \f$. */
+        SNrectangular<T,tp_columns,tp_lines> transpose() const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+constexpr SNrectangular<T,tp_lines,tp_columns>::SNrectangular():
+    data()
+{}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+constexpr SNrectangular<T,tp_lines,tp_columns>::SNrectangular(const std::array<T,tp_lines*tp_columns>& values):
+    SNrectangular(values,std::make_index_sequence<tp_lines*tp_columns>())
+{}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+template <std::size_t... Is>
+constexpr SNrectangular<T,tp_lines,tp_columns>::SNrectangular(const std::array<T,tp_lines*tp_columns>& values,std::index_sequence<Is...>):
+    data{{values[Is]...}}
+{}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+template <class U,unsigned int s>
+SNrectangular<T,tp_lines,tp_columns>::SNrectangular(const SNgeneric<U,s>& A):
+    data()
+{
+    static_assert(s==tp_lines and s==tp_columns,"The square matrix must have the dimensions of the rectangular one.");
+    for (m_num j=0;j<tp_columns;++j)
+    {
+        for (m_num i=0;i<tp_lines;++i)
+        {
+            (*this)(i,j)=A.get(i,j);
+        }
+    }
+}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+constexpr unsigned int SNrectangular<T,tp_lines,tp_columns>::getLines()
+{
+    return tp_lines;
+}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+constexpr unsigned int SNrectangular<T,tp_lines,tp_columns>::getColumns()
+{
+    return tp_columns;
+}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+constexpr T SNrectangular<T,tp_lines,tp_columns>::operator()(m_num i,m_num j) const
+{
+    return data[j*tp_lines+i];
+}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+T& SNrectangular<T,tp_lines,tp_columns>::operator()(m_num i,m_num j)
+{
+    return data[j*tp_lines+i];
+}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+T SNrectangular<T,tp_lines,tp_columns>::get(m_num i,m_num j) const
+{
+    if (i>=tp_lines or j>=tp_columns)
+    {
+        snThrow(RectangularOutOfRangeException(i,j,tp_lines,tp_columns));
+    }
+    return (*this)(i,j);
+}
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+T& SNrectangular<T,tp_lines,tp_columns>::at(m_num i,m_num j)
+{
+    if (i>=tp_lines or j>=tp_columns)
+    {
+        snThrow(RectangularOutOfRangeException(i,j,tp_lines,tp_columns));
+    }
+    return (*this)(i,j);
+}
+
+// MATHEMATICS -----------------------
+
+template <class T,unsigned int tp_lines,unsigned int tp_columns>
+SNrectangular<T,tp_columns,tp_lines> SNrectangular<T,tp_lines,tp_columns>::transpose() const
+{
+    SNrectangular<T,tp_columns,tp_lines> ans;
+    for (m_num j=0;j<tp_columns;++j)
+    {
+        for (m_num i=0;i<tp_lines;++i)
+        {
+            ans(j,i)=(*this)(i,j);
+        }
+    }
+    return ans;
+}
+
+// OPERATORS -----------------------
+
+template <class U,unsigned int l,unsigned int c,class V,unsigned int s,unsigned int t>
+bool operator==(const SNrectangular<U,l,c>& A,const SNrectangular<V,s,t>& B)
+{
+    static_assert(l==s and c==t,"The two matrices must have the same dimensions.");
+    for (m_num j=0;j<c;++j)
+    {
+        for (m_num i=0;i<l;++i)
+        {
+            if (A(i,j)!=B(i,j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+* \brief The product of a `tp_lines x tp_inner` matrix by a `tp_inner x tp_columns`
+* one, whose elements are read by `a(i,k)` and `b(k,j)`.
+*
+* The loops are ordered for the column major storage :
+* \f$ C_{:,j}=\sum_k B_{kj}A_{:,k} \f$.
+*/
+template <class U,unsigned int tp_lines,unsigned int tp_inner,unsigned int tp_columns,class FA,class FB>
+SNrectangular<U,tp_lines,tp_columns> rectangularProduct(const FA& a,const FB& b)
+{
+    SNrectangular<U,tp_lines,tp_columns> ans;
+    for (m_num j=0;j<tp_columns;++j)
+    {
+        for (m_num p=0;p<tp_inner;++p)
+        {
+            const U b_pj=b(p,j);
+            for (m_num i=0;i<tp_lines;++i)
+            {
+                ans(i,j)+=a(i,p)*b_pj;
+            }
+        }
+    }
+    return ans;
+}
+
+/** \brief `SNrectangular` * `SNrectangular`. */
+template <class U,unsigned int l,unsigned int k,class V,unsigned int s,unsigned int c>
+SNrectangular<U,l,c> operator*(const SNrectangular<U,l,k>& A,const SNrectangular<V,s,c>& B)
+{
+    static_assert(k==s,"The number of columns of the first matrix must be the number of lines of the second one.");
+    return rectangularProduct<U,l,k,c>(A,B);
+}
+
+/** 
+* \brief `SNmatrix` * `SNrectangular`.
+*
+* The elements of `A` are read in its storage, through its layout.
+*/
+template <class U,unsigned int s,class Layout,class V,unsigned int k,unsigned int c>
+SNrectangular<U,s,c> operator*(const SNmatrix<U,s,Layout>& A,const SNrectangular<V,k,c>& B)
+{
+    static_assert(s==k,"The size of the square matrix must be the number of lines of the rectangular one.");
+    return rectangularProduct<U,s,k,c>(A,B);
+}
+
+/** \brief `SNrectangular` * `SNmatrix`. */
+template <class U,unsigned int l,unsigned int k,class V,unsigned int s,class Layout>
+SNrectangular<U,l,s> operator*(const SNrectangular<U,l,k>& A,const SNmatrix<V,s,Layout>& B)
+{
+    static_assert(k==s,"The number of columns of the rectangular matrix must be the size of the square one.");
+    return rectangularProduct<U,l,k,s>(A,B);
+}
+
+/** 
+* \brief `SNgeneric` (square) * `SNrectangular`.
+*
+* For the other square types (triangular, ...) : the elements of `A`
+* are read by `get`.
+*/
+template <class U,unsigned int s,class V,unsigned int k,unsigned int c>
+SNrectangular<U,s,c> operator*(const SNgeneric<U,s>& A,const SNrectangular<V,k,c>& B)
+{
+    static_assert(s==k,"The size of the square matrix must be the number of lines of the rectangular one.");
+    return rectangularProduct<U,s,k,c>([&A](m_num i,m_num j) { return A.get(i,j); },B);
+}
+
+/** \brief `SNrectangular` * `SNgeneric` (square). */
+template <class U,unsigned int l,unsigned int k,class V,unsigned int s>
+SNrectangular<U,l,s> operator*(const SNrectangular<U,l,k>& A,const SNgeneric<V,s>& B)
+{
+    static_assert(k==s,"The number of columns of the rectangular matrix must be the size of the square one.");
+    return rectangularProduct<U,l,k,s>(A,[&B](m_num i,m_num j) { return B.get(i,j); });
+}
+
+/** \brief `SNrectangular` * `SNvector`. */
+template <class U,unsigned int l,unsigned int k,class V,unsigned int s>
+SNvector<U,l> operator*(const SNrectangular<U,l,k>& A,const SNvector<V,s>& v)
+{
+    static_assert(k==s,"The number of columns of the matrix must be the size of the vector.");
+    SNvector<U,l> ans;
+    U* res=ans.data();
+    const V* in=v.data();
+    for (m_num i=0;i<l;++i)
+    {
+        res[i]=0;
+    }
+    for (m_num p=0;p<k;++p)
+    {
+        const U b=in[p];
+        for (m_num i=0;i<l;++i)
+        {
+            res[i]+=A(i,p)*b;
+        }
+    }
+    return ans;
+}
+
+#endif
@@ -82,7 +82,7 @@ T& SNscalar<T,tp_size>::_at(const m_num& l, const m_num& c)
 {
     if (l!=c)
     {
-        throw SNchangeNotAllowedException(l,c);
+        snThrow(SNchangeNotAllowedException(l,c));
     }
     return data;
 }
@@ -0,0 +1,184 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNUNROLLED_H__161902__
+#define __SNUNROLLED_H__161902__
+
+#include <type_traits>
+#include <utility>
+
+/*
+Fully unrolled kernels for the small matrices.
+
+For a size up to `unrolled_max_size`, the products, the substitutions and
+the PLU decomposition are written with `unrolledFor` : every loop index is
+a compile-time constant, so that there remains no loop, no virtual call and
+no `m_num`, and the elements of a small matrix can live in registers.
+
+The operations are done in the same order as the generic loops : the
+results are exactly the same.
+
+The matrix arguments are accessed through an unchecked `operator()(i,j)`.
+*/
+
+/** The sizes up to this one use the unrolled kernels. */
+constexpr unsigned int unrolled_max_size=8;
+
+/** `std::true_type` when the size `tp_size` uses the unrolled kernels. */
+template <unsigned int tp_size>
+using SNuseUnrolled=std::integral_constant<bool,(tp_size<=unrolled_max_size)>;
+
+template <unsigned int tp_first,class F,std::size_t... Is>
+inline void unrolledFor(F&& f,std::index_sequence<Is...>)
+{
+    // the elements of a braced list are evaluated in order.
+    const int expand[]={0,(f(std::integral_constant<unsigned int,tp_first+Is>()),0)...};
+    (void)expand;
+}
+
+/**
+* @brief Call `f(k)` for `k=tp_first,...,tp_last-1` where `k` is a
+* `std::integral_constant` : in the body, `decltype(k)::value` is a constant
+* expression.
+*
+* ```
+* unrolledFor<0,3>([&](auto k) { sum+=v[k]; });    // sum+=v[0]; sum+=v[1]; sum+=v[2];
+* ```
+**/
+template <unsigned int tp_first,unsigned int tp_last,class F>
+inline void unrolledFor(F&& f)
+{
+    unrolledFor<tp_first>(f,std::make_index_sequence<(tp_last>tp_first ? tp_last-tp_first : 0)>());
+}
+
+/**
+* @brief \f$ C=AB \f$, with elements of type `T`. The sum for each element starts at \f$ k=0 \f$, as
+* in `matrixProductComponent`.
+**/
+template <unsigned int tp_size,class T,class MA,class MB,class MC>
+inline void unrolledProduct(const MA& A,const MB& B,MC& C)
+{
+    unrolledFor<0,tp_size>([&](auto j)
+        {
+            constexpr unsigned int jj=decltype(j)::value;
+            unrolledFor<0,tp_size>([&](auto i)
+                {
+                    constexpr unsigned int ii=decltype(i)::value;
+                    T acc=0;
+                    unrolledFor<0,tp_size>([&](auto k)
+                        {
+                            constexpr unsigned int kk=decltype(k)::value;
+                            acc+=A(ii,kk)*B(kk,jj);
+                        });
+                    C(ii,jj)=acc;
+                });
+        });
+}
+
+/**
+* @brief Replace `x` by \f$ L^{-1}x \f$, where the diagonal of \f$ L \f$
+* is 1 (it is not read).
+**/
+template <unsigned int tp_size,class ML,class T>
+inline void unrolledUnitLowerSolve(const ML& mL,T* x)
+{
+    unrolledFor<1,tp_size>([&](auto i)
+        {
+            constexpr unsigned int ii=decltype(i)::value;
+            T acc=x[ii];
+            unrolledFor<0,ii>([&](auto k)
+                {
+                    constexpr unsigned int kk=decltype(k)::value;
+                    acc-=mL(ii,kk)*x[kk];
+                });
+            x[ii]=acc;
+        });
+}
+
+/** @brief Replace `x` by \f$ U^{-1}x \f$. */
+template <unsigned int tp_size,class MU,class T>
+inline void unrolledUpperSolve(const MU& mU,T* x)
+{
+    unrolledFor<0,tp_size>([&](auto r)
+        {
+            constexpr unsigned int i=tp_size-1-decltype(r)::value;
+            T acc=x[i];
+            unrolledFor<i+1,tp_size>([&](auto k)
+                {
+                    constexpr unsigned int kk=decltype(k)::value;
+                    acc-=mU(i,kk)*x[kk];
+                });
+            x[i]=acc/mU(i,i);
+        });
+}
+
+/**
+* @brief The PLU decomposition of the column major matrix `a`, in place.
+*
+* At the end, `a` contains \f$ U \f$ on and above the diagonal and \f$ L \f$
+* (whose diagonal is 1) under the diagonal; the line `i` of \f$ LU \f$ is the line
+* `rows[i]` of the matrix. The pivots are the ones of `SNmatrix::getPLU`.
+**/
+template <unsigned int tp_size,class T>
+inline void unrolledFactorize(T* a,unsigned int* rows)
+{
+    unrolledFor<0,tp_size>([&](auto k)
+        {
+            rows[k]=k;
+        });
+    unrolledFor<0,tp_size>([&](auto c)
+        {
+            constexpr unsigned int cc=decltype(c)::value;
+            unsigned int max_line=cc;
+            T max_val=0;
+            unrolledFor<cc,tp_size>([&](auto l)
+                {
+                    const T v=a[cc*tp_size+l]<0 ? -a[cc*tp_size+l] : a[cc*tp_size+l];
+                    if (v>max_val)
+                    {
+                        max_val=v;
+                        max_line=l;
+                    }
+                });
+            if (max_val==0)
+            {
+                return;
+            }
+            // on the last column there is nothing to swap.
+            if (cc+1<tp_size and max_line!=cc)
+            {
+                unrolledFor<0,tp_size>([&](auto j)
+                    {
+                        std::swap(a[j*tp_size+cc],a[j*tp_size+max_line]);
+                    });
+                std::swap(rows[cc],rows[max_line]);
+            }
+            const T pivot=a[cc*tp_size+cc];
+            unrolledFor<cc+1,tp_size>([&](auto l)
+                {
+                    const T m=a[cc*tp_size+l]/pivot;
+                    a[cc*tp_size+l]=m;
+                    unrolledFor<cc+1,tp_size>([&](auto j)
+                        {
+                            a[j*tp_size+l]-=m*a[j*tp_size+cc];
+                        });
+                });
+        });
+}
+
+#endif
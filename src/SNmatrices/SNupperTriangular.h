@@ -49,6 +49,12 @@ class SNupperTriangular : public SNgeneric<T,tp_size>
          * */
         std::array<T,tp_size*tp_size> _get_other_data(const SNmatrix<T,tp_size>&) const;
 
+        /** 
+         * @brief Unchecked access to the element (i,j), which has to be in the
+         * upper triangle (included the diagonal). For the unrolled kernels (SNunrolled.h).
+         * */
+        T operator()(m_num i,m_num j) const;
+
         SNupperTriangular();
         explicit SNupperTriangular(const SNmatrix<T,tp_size>& A);
 
@@ -86,6 +92,12 @@ SNupperTriangular<T,tp_size>::SNupperTriangular(const SNmatrix<T,tp_size>& A):
     data(_get_other_data(A)) 
 {};
 
+template <class T,unsigned int tp_size>
+T SNupperTriangular<T,tp_size>::operator()(m_num i,m_num j) const
+{
+    return data[j*tp_size+i];
+}
+
 // _GET AND _AT METHODS ---------------------------------------
 
 template <class T,unsigned int tp_size>
@@ -103,7 +115,7 @@ T& SNupperTriangular<T,tp_size>::_at(const m_num& l,const m_num& c)
 {
     if (l>c)
     {
-        throw SNchangeNotAllowedException(l,c);
+        snThrow(SNchangeNotAllowedException(l,c));
     }
     return data.at(c*tp_size+l);
 }
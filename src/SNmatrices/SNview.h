@@ -0,0 +1,270 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNVIEW_H__113307__
+#define __SNVIEW_H__113307__
+
+#include <type_traits>
+#include <utility>
+
+#include "m_num.h"
+#include "SNlayout.h"
+#include "../exceptions/SNexceptions.cpp"
+
+/*
+Line and column views on the storage of a `SNmatrix`.
+
+A view does not own anything : it is a pointer to the storage of the
+matrix and a line (or column) number. Reading or writing through a view
+reads or writes the matrix itself, without copy. The place of the
+elements is given by the layout, so that the views work with every
+layout; with `ColumnMajor`, `RowMajor` and `PaddedColumnMajor` the compiler
+sees a strided access.
+
+A view is valid as long as the matrix exists. A view on a const matrix
+has the type `SNlineView<const T,...>`.
+*/
+
+// THE CLASS HEADERS -----------------------------------------
+
+/**
+* @brief A non-owning view on the line `line` of a `SNmatrix`.
+*
+* The constness is the one of `T`, not the one of the view : like a
+* pointer, a `const SNlineView<double,n>` can modify the matrix.
+**/
+template <class T,unsigned int tp_size,class Layout=ColumnMajor>
+class SNlineView
+{
+    private :
+        T* data;
+        m_num line;
+    public :
+        typedef typename std::remove_const<T>::type value_type;
+
+        SNlineView(T* data,m_num line);
+
+        m_num getLine() const;
+
+        /** Unchecked access to the elements, for the inner loops. */
+        T& operator[](m_num c) const;
+
+        /** throw `SNoutOfRangeException` if `c` is out of range */
+        value_type get(m_num c) const;
+        T& at(m_num c) const;
+
+        /** @brief Multiply the elements `first` to `tp_size-1` by `m`. */
+        void scale(const value_type& m,m_num first=0) const;
+
+        /**
+         * @brief Subtract `m*other` from this line, on the columns `first`
+         * to `tp_size-1`.
+         *
+         * This is the Gaussian elimination step : no intermediate line
+         * is created.
+         * */
+        template <class U>
+        void subtractScaled(const value_type& m,const SNlineView<U,tp_size,Layout>& other,m_num first=0) const;
+
+        /** @brief Swap the elements of the two lines. */
+        void swap(const SNlineView<T,tp_size,Layout>& other) const;
+};
+
+/**
+* @brief A non-owning view on the column `column` of a `SNmatrix`.
+*
+* See `SNlineView`.
+**/
+template <class T,unsigned int tp_size,class Layout=ColumnMajor>
+class SNcolumnView
+{
+    private :
+        T* data;
+        m_num column;
+    public :
+        typedef typename std::remove_const<T>::type value_type;
+
+        SNcolumnView(T* data,m_num column);
+
+        m_num getColumn() const;
+
+        /** Unchecked access to the elements, for the inner loops. */
+        T& operator[](m_num l) const;
+
+        /** throw `SNoutOfRangeException` if `l` is out of range */
+        value_type get(m_num l) const;
+        T& at(m_num l) const;
+
+        /** @brief Multiply the elements `first` to `tp_size-1` by `m`. */
+        void scale(const value_type& m,m_num first=0) const;
+
+        /** @brief Subtract `m*other` from this column, on the lines `first` to `tp_size-1`. */
+        template <class U>
+        void subtractScaled(const value_type& m,const SNcolumnView<U,tp_size,Layout>& other,m_num first=0) const;
+
+        /** @brief Swap the elements of the two columns. */
+        void swap(const SNcolumnView<T,tp_size,Layout>& other) const;
+};
+
+// LINE VIEW -----------------------------------------
+
+template <class T,unsigned int tp_size,class Layout>
+SNlineView<T,tp_size,Layout>::SNlineView(T* d,m_num l):
+    data(d),
+    line(l)
+{
+    if (l>=tp_size)
+    {
+        snThrow(SNoutOfRangeException(l,0,tp_size));
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNlineView<T,tp_size,Layout>::getLine() const
+{
+    return line;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNlineView<T,tp_size,Layout>::operator[](m_num c) const
+{
+    return data[Layout::index(line,c,tp_size)];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+typename SNlineView<T,tp_size,Layout>::value_type SNlineView<T,tp_size,Layout>::get(m_num c) const
+{
+    return at(c);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNlineView<T,tp_size,Layout>::at(m_num c) const
+{
+    if (c>=tp_size)
+    {
+        snThrow(SNoutOfRangeException(line,c,tp_size));
+    }
+    return (*this)[c];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+void SNlineView<T,tp_size,Layout>::scale(const value_type& m,m_num first) const
+{
+    for (m_num c=first;c<tp_size;++c)
+    {
+        (*this)[c]*=m;
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U>
+void SNlineView<T,tp_size,Layout>::subtractScaled(const value_type& m,const SNlineView<U,tp_size,Layout>& other,m_num first) const
+{
+    for (m_num c=first;c<tp_size;++c)
+    {
+        (*this)[c]-=m*other[c];
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+void SNlineView<T,tp_size,Layout>::swap(const SNlineView<T,tp_size,Layout>& other) const
+{
+    if (&(*this)[0]==&other[0])
+    {
+        return;
+    }
+    for (m_num c=0;c<tp_size;++c)
+    {
+        std::swap((*this)[c],other[c]);
+    }
+}
+
+// COLUMN VIEW -----------------------------------------
+
+template <class T,unsigned int tp_size,class Layout>
+SNcolumnView<T,tp_size,Layout>::SNcolumnView(T* d,m_num c):
+    data(d),
+    column(c)
+{
+    if (c>=tp_size)
+    {
+        snThrow(SNoutOfRangeException(0,c,tp_size));
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+m_num SNcolumnView<T,tp_size,Layout>::getColumn() const
+{
+    return column;
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNcolumnView<T,tp_size,Layout>::operator[](m_num l) const
+{
+    return data[Layout::index(l,column,tp_size)];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+typename SNcolumnView<T,tp_size,Layout>::value_type SNcolumnView<T,tp_size,Layout>::get(m_num l) const
+{
+    return at(l);
+}
+
+template <class T,unsigned int tp_size,class Layout>
+T& SNcolumnView<T,tp_size,Layout>::at(m_num l) const
+{
+    if (l>=tp_size)
+    {
+        snThrow(SNoutOfRangeException(l,column,tp_size));
+    }
+    return (*this)[l];
+}
+
+template <class T,unsigned int tp_size,class Layout>
+void SNcolumnView<T,tp_size,Layout>::scale(const value_type& m,m_num first) const
+{
+    for (m_num l=first;l<tp_size;++l)
+    {
+        (*this)[l]*=m;
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+template <class U>
+void SNcolumnView<T,tp_size,Layout>::subtractScaled(const value_type& m,const SNcolumnView<U,tp_size,Layout>& other,m_num first) const
+{
+    for (m_num l=first;l<tp_size;++l)
+    {
+        (*this)[l]-=m*other[l];
+    }
+}
+
+template <class T,unsigned int tp_size,class Layout>
+void SNcolumnView<T,tp_size,Layout>::swap(const SNcolumnView<T,tp_size,Layout>& other) const
+{
+    if (&(*this)[0]==&other[0])
+    {
+        return;
+    }
+    for (m_num l=0;l<tp_size;++l)
+    {
+        std::swap((*this)[l],other[l]);
+    }
+}
+
+#endif
@@ -21,12 +21,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __MNUM_H__094427__
 
 #import <iostream>
+#include <cassert>
+#include <type_traits>
 
 /**
     This class is a wrapper for (a priori) `unsigned int`.
 
     It represents a number of line or column in a matrix.
 
+    `m_num` is header-only, trivially copyable, and its member functions are
+    `constexpr` and `noexcept` : in the loops it costs exactly what an
+    `unsigned int` costs, and it can be used in the compile-time computations
+    (see `SNconstexprPLU`).
+
+    The construction from a negative `int` is only checked (by `assert`)
+    when `NDEBUG` is not defined.
+
     For the moment, the template parameter for the matrix size itself
     remains 'unsigned int'.
 */
@@ -37,25 +47,85 @@ class m_num
         unsigned int num;
     public :
         //cppcheck-suppress noExplicitConstructor
-        m_num(const unsigned int n);  
-        explicit m_num(const int n); 
+        constexpr m_num(const unsigned int n) noexcept;  
+        constexpr explicit m_num(const int n) noexcept; 
 
-        m_num operator++();  // ++i
-        m_num operator++(int);  // i++
+        constexpr m_num operator++() noexcept;  // ++i
+        constexpr m_num operator++(int) noexcept;  // i++
 
-        bool operator >(const unsigned int& b) const;
-        bool operator >(const m_num& b) const;
-        bool operator >(const int& b) const;
+        constexpr bool operator >(const unsigned int& b) const noexcept;
+        constexpr bool operator >(const m_num& b) const noexcept;
+        constexpr bool operator >(const int& b) const noexcept;
         
-        bool operator <(const unsigned int& b) const;
-        bool operator <(const m_num& b) const;
-        bool operator <(const int& b) const;
+        constexpr bool operator <(const unsigned int& b) const noexcept;
+        constexpr bool operator <(const m_num& b) const noexcept;
+        constexpr bool operator <(const int& b) const noexcept;
 
         /** Allows conversion to `unsigned int` */
-        operator unsigned int() const;
+        constexpr operator unsigned int() const noexcept;
 
-        void swap(m_num& other);
+        constexpr void swap(m_num& other) noexcept;
 };
 
+static_assert(std::is_trivially_copyable<m_num>::value,"m_num has to be as cheap as an unsigned int");
+static_assert(sizeof(m_num)==sizeof(unsigned int),"m_num has to be as cheap as an unsigned int");
+
+// CONSTRUCTOR --------------------------------
+
+constexpr m_num::m_num(const unsigned int n) noexcept : 
+    num(n)
+{}
+
+constexpr m_num::m_num(const int n) noexcept :
+    num(static_cast<unsigned int>(n))
+{
+    assert(n>=0 && "A line or column number cannot be negative");
+}
+
+constexpr void m_num::swap(m_num& other) noexcept
+{
+    const unsigned int tmp=num;
+    num=other.num;
+    other.num=tmp;
+}
+
+// CONVERSIONS   ----------------------------------
+
+constexpr m_num::operator unsigned int() const noexcept
+{
+    return num;
+}
+
+// INCREMENT  ----------------------------------
+
+constexpr m_num m_num::operator++() noexcept
+{
+    ++num;
+    return *this;
+}
+constexpr m_num m_num::operator++(int) noexcept
+{
+    m_num tmp(*this);
+    ++num;
+    return tmp;
+}
+
+// COMPARISON -------------------------- 
+
+constexpr bool m_num::operator >(const unsigned int& b) const noexcept { return num>b; }
+constexpr bool m_num::operator >(const m_num& b) const noexcept { return num>b.num; }
+constexpr bool m_num::operator >(const int& b) const noexcept
+{ 
+    return int(num)>b; 
+}
+constexpr bool m_num::operator <(const unsigned int& b) const noexcept
+{
+    return num<b;
+}
+constexpr bool m_num::operator <(const m_num& b) const noexcept { return num<b.num; }
+constexpr bool m_num::operator <(const int& b) const noexcept
+{ 
+    return int(num)<b; 
+}
 
 #endif
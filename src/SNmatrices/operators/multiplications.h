@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../SNupperTriangular.h"
 #include "../SNscalar.h"
 #include "../MathUtilities.h"
+#include "../SNunrolled.h"
 #include "../../exceptions/SNexceptions.cpp"
 
 /**
@@ -62,6 +63,35 @@ SNmatrix<U,s> operator*(const SNgeneric<U,s>& A, const SNgeneric<V,t>& B)
     return ans;   //relies on RVO.
 }
 
+// SNmatrix * SNmatrix
+
+template <class U,class V,unsigned int s,unsigned int t>
+SNmatrix<U,s> matrixProduct(const SNmatrix<U,s>& A, const SNmatrix<V,t>& B,std::true_type)
+{
+    SNmatrix<U,s> ans;
+    unrolledProduct<s,U>(A,B,ans);
+    return ans;
+}
+
+template <class U,class V,unsigned int s,unsigned int t>
+SNmatrix<U,s> matrixProduct(const SNmatrix<U,s>& A, const SNmatrix<V,t>& B,std::false_type)
+{
+    return static_cast<const SNgeneric<U,s>&>(A)*static_cast<const SNgeneric<V,t>&>(B);
+}
+
+/**
+* \brief `SNmatrix` * `SNmatrix`.
+*
+* Up to the size `unrolled_max_size`, the product is fully unrolled (see
+* SNunrolled.h). The larger sizes use the generic product.
+*/
+template <class U,class V,unsigned int s,unsigned int t>
+SNmatrix<U,s> operator*(const SNmatrix<U,s>& A, const SNmatrix<V,t>& B)
+{
+    checkSizeCompatibility(A,B);
+    return matrixProduct(A,B,SNuseUnrolled<s>());
+}
+
 // number * identity
 
 /** 
@@ -415,6 +445,8 @@ SNmultiGaussian<U,s> operator*
 /** 
  * The multiplication "permutation1 * permutation2" 
  * is the composition. 
+ *
+ * The arrays are read directly : no virtual `image` and no range check.
 */
 template <unsigned int tp_size>
 Mpermutation<tp_size> operator*
@@ -423,7 +455,7 @@ Mpermutation<tp_size> operator*
     Mpermutation<tp_size> new_perm;
     for (unsigned int i=0;i<tp_size;++i)
     {
-        new_perm.at(i)=p1.image( p2.image(i) );
+        new_perm.data[i]=p1.data[ p2.data[i] ];
     }
     return new_perm;
 }
@@ -0,0 +1,225 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNMIXEDPRECISION_H__151822__
+#define __SNMIXEDPRECISION_H__151822__
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include "SNplu.h"
+#include "SNvector.h"
+#include "SNmatrices/SNmatrix.h"
+
+
+/**
+* @brief What happened during a `SNmixedPrecisionSolver::solve`.
+**/
+class RefinementReport
+{
+    public :
+        unsigned int iterations=0;  // number of corrections computed in float
+        bool converged=false;       // the refinement reached the double accuracy
+        bool fallback=false;        // the double decomposition was used
+};
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief Solve \f$ Ax=b \f$ in double precision with a decomposition in float.
+*
+* The PLU decomposition is done with `SNmatrix<float,tp_size>::getPLU()` : half
+* the memory and twice as many elements per SIMD register. Then the
+* solution is refined :
+* \f[
+*   r=b-Ax,\quad d=(LU)^{-1}P^{-1}r,\quad x\leftarrow x+d
+* \f]
+* where the residual \f$ r \f$ is computed in `long double` and \f$ x \f$ is
+* kept in double. The refinement stops when
+* \f[
+*   \|r\|_{\infty}\leq\|x\|_{\infty}\|A\|_{\infty}\epsilon\sqrt{n}
+* \f]
+* with \f$ \epsilon \f$ the machine precision of double (this is the criterion
+* of LAPACK's `dsgesv`).
+*
+* If the criterion is not reached within `max_iterations`, or if the
+* residual stops decreasing (the matrix is too ill-conditioned for
+* float), the system is solved with a double decomposition of \f$ A \f$,
+* computed the first time it is needed.
+*
+* `solve` is thread-safe.
+**/
+template <unsigned int tp_size>
+class SNmixedPrecisionSolver
+{
+    private :
+        const SNmatrix<double,tp_size> data_A;
+        const double data_norm_A;
+        const unsigned int data_max_iterations;
+        const SNplu<float,tp_size> data_plu_float;
+
+        mutable std::once_flag data_double_once;
+        mutable std::shared_ptr<const SNplu<double,tp_size>> data_plu_double;
+
+        static SNmatrix<float,tp_size> toFloat(const SNmatrix<double,tp_size>& A);
+        static double normInf(const SNmatrix<double,tp_size>& A);
+
+        /** return \f$ (PLU)^{-1}r \f$ with the float decomposition */
+        SNvector<double,tp_size> correction(const SNvector<double,tp_size>& r) const;
+        const SNplu<double,tp_size>& getDoublePLU() const;
+    public :
+        /**
+         * @brief Decompose `A` in float.
+         * */
+        explicit SNmixedPrecisionSolver(const SNmatrix<double,tp_size>& A,unsigned int max_iterations=30);
+
+        /**
+         * @brief Return the solution of \f$ Ax=b \f$ ; `report` says how it
+         * was obtained.
+         * */
+        SNvector<double,tp_size> solve(const SNvector<double,tp_size>& b,RefinementReport& report) const;
+        SNvector<double,tp_size> solve(const SNvector<double,tp_size>& b) const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <unsigned int tp_size>
+SNmixedPrecisionSolver<tp_size>::SNmixedPrecisionSolver(const SNmatrix<double,tp_size>& A,unsigned int max_iterations):
+    data_A(A),
+    data_norm_A(normInf(A)),
+    data_max_iterations(max_iterations),
+    data_plu_float(toFloat(A).getPLU())
+{}
+
+template <unsigned int tp_size>
+SNmatrix<float,tp_size> SNmixedPrecisionSolver<tp_size>::toFloat(const SNmatrix<double,tp_size>& A)
+{
+    SNmatrix<float,tp_size> F;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<tp_size;++j)
+        {
+            F.at(i,j)=static_cast<float>(A.get(i,j));
+        }
+    }
+    return F;
+}
+
+template <unsigned int tp_size>
+double SNmixedPrecisionSolver<tp_size>::normInf(const SNmatrix<double,tp_size>& A)
+{
+    double norm=0;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        double sum=0;
+        for (m_num j=0;j<tp_size;++j)
+        {
+            sum+=std::abs(A.get(i,j));
+        }
+        norm=std::max(norm,sum);
+    }
+    return norm;
+}
+
+template <unsigned int tp_size>
+const SNplu<double,tp_size>& SNmixedPrecisionSolver<tp_size>::getDoublePLU() const
+{
+    std::call_once(data_double_once,[this]
+        {
+            data_plu_double=std::make_shared<const SNplu<double,tp_size>>(data_A.getPLU());
+        });
+    return *data_plu_double;
+}
+
+// SOLVING SYSTEMS -----------------------
+
+template <unsigned int tp_size>
+SNvector<double,tp_size> SNmixedPrecisionSolver<tp_size>::correction(const SNvector<double,tp_size>& r) const
+{
+    SNvector<float,tp_size> rf;
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        rf.at(i)=static_cast<float>(r.get(i));
+    }
+    auto df=data_plu_float.solve(rf);
+    SNvector<double,tp_size> d;
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        d.at(i)=df.get(i);
+    }
+    return d;
+}
+
+template <unsigned int tp_size>
+SNvector<double,tp_size> SNmixedPrecisionSolver<tp_size>::solve(const SNvector<double,tp_size>& b,RefinementReport& report) const
+{
+    report=RefinementReport();
+    const double tolerance=data_norm_A*std::numeric_limits<double>::epsilon()*std::sqrt(double(tp_size));
+
+    SNvector<double,tp_size> x=correction(b);
+    double previous_residual=std::numeric_limits<double>::infinity();
+    SNvector<double,tp_size> r;
+    while (true)
+    {
+        double norm_r=0;
+        double norm_x=0;
+        for (m_num i=0;i<tp_size;++i)
+        {
+            long double acc=b.get(i);
+            for (m_num j=0;j<tp_size;++j)
+            {
+                acc-=static_cast<long double>(data_A.get(i,j))*x.get(j);
+            }
+            r.at(i)=static_cast<double>(acc);
+            norm_r=std::max(norm_r,std::abs(r.get(i)));
+            norm_x=std::max(norm_x,std::abs(x.get(i)));
+        }
+        if (norm_r<=norm_x*tolerance)
+        {
+            report.converged=true;
+            return x;
+        }
+        // no progress, or not a number (a zero pivot in float)
+        if (report.iterations==data_max_iterations or !(norm_r<previous_residual))
+        {
+            break;
+        }
+        previous_residual=norm_r;
+
+        auto d=correction(r);
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            x.at(i)+=d.get(i);
+        }
+        ++report.iterations;
+    }
+    report.fallback=true;
+    return getDoublePLU().solve(b);
+}
+
+template <unsigned int tp_size>
+SNvector<double,tp_size> SNmixedPrecisionSolver<tp_size>::solve(const SNvector<double,tp_size>& b) const
+{
+    RefinementReport report;
+    return solve(b,report);
+}
+
+#endif
@@ -20,43 +20,244 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __SNPLU_H__142039__
 
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "SNvector.h"
+#include "ThreadPool.h"
+#include "Utilities.h"
+#include "SNarena.h"
+#include "SNmatrices/SNunrolled.h"
 #include "SNmatrices/SNmatrix.h"
 #include "SNmatrices/SNupperTriangular.h"
 #include "SNmatrices/SNpermutation.h"
 #include "SNmatrices/Mpermutation.h"
+#include "SNmatrices/MpivotSequence.h"
 
 
 // THE CLASS HEADER -----------------------------------------
 
+/**
+* @brief The PLU decomposition of a matrix : \f$ A=PLU \f$.
+*
+* The object is immutable. In particular `solve` does not modify anything
+* and uses no shared buffer : many threads can solve at the same time with
+* the same `SNplu`.
+*
+* The factors are stored once, on the heap, and shared between the copies
+* (they are never modified). Copying, moving or assigning a `SNplu`, for
+* example when handing it to a cache or to another thread, costs a pointer
+* copy, not three \f$ n^2 \f$ arrays.
+**/
 template <class T,unsigned int tp_size>
 class SNplu
 {
 
     friend SNplu<T,tp_size> SNmatrix<T,tp_size>::getPLU() const;
+    friend class UnrolledTest;
 
     private :
-        const Mpermutation<tp_size> data_P; 
-        const SNlowerTriangular<T,tp_size> data_L;
-        const SNupperTriangular<T,tp_size> data_U;
+        class Factors
+        {
+            public :
+                const Mpermutation<tp_size> P;
+                const SNlowerTriangular<T,tp_size> L;
+                const SNupperTriangular<T,tp_size> U;
+                Factors(const Mpermutation<tp_size>& mP,const SNlowerTriangular<T,tp_size>& mL,const SNupperTriangular<T,tp_size>& mU):
+                    P(mP),
+                    L(mL),
+                    U(mU)
+                {}
+        };
+        std::shared_ptr<const Factors> data_factors;
+
+        // 'refactor' and 'inverse', with the scratch memory taken from 'alloc'.
+        // When 'arena' is not null, the returned factors are stored there.
+        template <class Allocator>
+        SNplu<T,tp_size> refactor(const SNmatrix<T,tp_size>& A,T threshold,const Allocator& alloc,SNarena* arena) const;
+        template <class Allocator>
+        SNmatrix<T,tp_size> inverse(const Allocator& alloc) const;
+
+        // 'solve(b)' for the small sizes (fully unrolled) and the other ones.
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b,std::true_type) const;
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b,std::false_type) const;
     public:
 
         /** @brief constructor from the already computed P,L and U.
          * */
         SNplu(const Mpermutation<tp_size>& mP,const SNlowerTriangular<T,tp_size>& mL,const SNupperTriangular<T,tp_size>& mU);
 
+        /** @brief Idem, with the factors stored in `arena` (see `SNarena`). */
+        SNplu(const Mpermutation<tp_size>& mP,const SNlowerTriangular<T,tp_size>& mL,const SNupperTriangular<T,tp_size>& mU,SNarena& arena);
+
         const SNpermutation<T,tp_size> getP() const;
-        const SNlowerTriangular<T,tp_size> getL() const;
-        const SNupperTriangular<T,tp_size> getU() const;
-        const Mpermutation<tp_size> getMpermutation() const;
+
+        /** The factors are returned by reference : there is no copy. */
+        const SNlowerTriangular<T,tp_size>& getL() const;
+        const SNupperTriangular<T,tp_size>& getU() const;
+        const Mpermutation<tp_size>& getMpermutation() const;
+
+        /** @brief The memory used by the decomposition, in bytes. */
+        std::size_t getMemoryUsage() const;
+
+        /**
+         * @brief Return the solution of \f$ Ax=b \f$.
+         *
+         * Since \f$ A=PLU \f$, one computes \f$ y=P^{-1}b \f$ then solves
+         * \f$ Lz=y \f$ and \f$ Ux=z \f$ by substitution.
+         *
+         * This is thread-safe : the only memory written is the returned vector.
+         * */
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b) const;
+
+        /**
+         * @brief Put in `x` the solution of \f$ Ax=b \f$ and return `SNstatus::ok`.
+         *
+         * When the matrix is singular (a zero pivot), return `SNstatus::singular`
+         * and `x` is not modified. This never throws : this is the version of `solve`
+         * for the code that checks the result.
+         * */
+        SNstatus solve(const SNvector<T,tp_size>& b,SNvector<T,tp_size>& x) const;
+
+        /**
+         * @brief Return the solution of \f$ A^Tx=b \f$.
+         *
+         * Since \f$ A^T=U^TL^TP^{-1} \f$, one solves \f$ U^Tz=b \f$ and
+         * \f$ L^Tw=z \f$, then \f$ x=Pw \f$.
+         * */
+        SNvector<T,tp_size> solveTransposed(const SNvector<T,tp_size>& b) const;
+
+        /**
+         * @brief Solve \f$ Ax=b \f$ for each of the given vectors, sharing
+         * the work between the threads of the pool.
+         *
+         * The solutions are returned in the same order as `rhs`.
+         * */
+        std::vector<SNvector<T,tp_size>> solve_many(const std::vector<SNvector<T,tp_size>>& rhs,ThreadPool& pool) const;
+
+        /**
+         * @brief Return the PLU decomposition of `A`, reusing the
+         * permutation of this decomposition when possible.
+         *
+         * This is meant for a matrix whose coefficients changed a little
+         * (the next time step of an implicit scheme). The lines of `A` are
+         * permuted by \f$ P^{-1} \f$ and the elimination is done without
+         * searching for the pivots.
+         *
+         * At each step, the pivot is accepted when
+         * \f[ |u_{cc}| \geq threshold\cdot\max_{l\geq c}|a_{lc}| \f]
+         * (`threshold=1` asks for the pivots of `getPLU()`, `threshold=0`
+         * accepts everything but a zero). When one pivot is not acceptable,
+         * the elimination is abandoned and the result is `A.getPLU()`.
+         *
+         * One knows which way was taken by comparing `getMpermutation()`.
+         * */
+        SNplu<T,tp_size> refactor(const SNmatrix<T,tp_size>& A,T threshold=0.1) const;
+
+        /**
+         * @brief Same as `refactor(A,threshold)`, with the scratch memory and
+         * the returned factors taken in `arena` : no heap allocation once
+         * the arena is large enough.
+         * */
+        SNplu<T,tp_size> refactor(const SNmatrix<T,tp_size>& A,SNarena& arena,T threshold=0.1) const;
+
+        /**
+         * @brief Return an estimate of \f$ \|A^{-1}\|_1 \f$.
+         *
+         * This is the algorithm of Hager as improved by Higham (the one of
+         * LAPACK's `dlacon`) : at most 5 iterations, each of them being
+         * one `solve` and one `solveTransposed`. The cost is thus
+         * \f$ O(n^2) \f$. The result is a lower bound which is most often
+         * exact.
+         *
+         * Return the infinity when there is a zero pivot.
+         * */
+        T estimateInverseNorm1() const;
+
+        /**
+         * @brief Return an estimate of the condition number
+         * \f$ \|A\|_1\|A^{-1}\|_1 \f$.
+         *
+         * The decomposition does not remember `A` : as for LAPACK's
+         * `dgecon`, one has to give it (only \f$ \|A\|_1 \f$ is computed).
+         * */
+        T estimateCondition1(const SNgeneric<T,tp_size>& A) const;
+
+        /**
+         * @brief Return the pivot growth factor
+         * \f$ \max_{ij}|u_{ij}|/\max_{ij}|a_{ij}| \f$.
+         *
+         * A large growth (compared to 1) means that the decomposition
+         * lost accuracy, even if the condition number is small.
+         * */
+        T getPivotGrowth(const SNgeneric<T,tp_size>& A) const;
+
+        /**
+         * @brief Return the number of columns that were full of zeros
+         * under the diagonal during the elimination.
+         *
+         * These are the zeros on the diagonal of U. If this is not 0,
+         * the matrix is not invertible and `solve` returns non-numbers.
+         * */
+        unsigned int getZeroPivotCount() const;
+
+        /**
+         * @brief Return the determinant of A.
+         *
+         * This is the product of the diagonal of U times the signature of
+         * the permutation. The cost is \f$ O(n) \f$.
+         *
+         * For the large matrices, the product easily overflows ; see
+         * `logAbsDeterminant`.
+         * */
+        T determinant() const;
+
+        /**
+         * @brief Return \f$ \ln|\det A| \f$ and put the sign of
+         * \f$ \det A \f$ in `sign`.
+         *
+         * This is the sum of the \f$ \ln|u_{ii}| \f$, which neither overflows
+         * nor underflows. The sign (1 or -1) is the signature of the
+         * permutation times the signs of the \f$ u_{ii} \f$ ; it is
+         * computed separately because the sign of `determinant()` is lost
+         * when the product underflows to zero or becomes a NaN.
+         *
+         * When A is not invertible, return \f$ -\infty \f$ and `sign` is 0.
+         * */
+        T logAbsDeterminant(int& sign) const;
+
+        /**
+         * @brief Return the inverse of A.
+         *
+         * The columns of \f$ A^{-1} \f$ are the solutions of \f$ Ax=e_j \f$.
+         * They are computed together, by blocks of columns, in the
+         * same array : for each column of L (and of U), the updates of
+         * all the columns of the block are done before passing to the
+         * next one. The column \f$ P^{-1}e_j \f$ has a single non zero
+         * element ; the substitution with L starts there.
+         *
+         * Prints a warning (once) : most of the time one wants `solve`.
+         * */
+        SNmatrix<T,tp_size> inverse() const;
+
+        /** @brief Same as `inverse()`, with the scratch memory taken in `arena`. */
+        SNmatrix<T,tp_size> inverse(SNarena& arena) const;
 };
 
 // CONSTRUCTORS -----------------------
 
 template <class T,unsigned int tp_size>
 SNplu<T,tp_size>::SNplu(const Mpermutation<tp_size>& mP,const SNlowerTriangular<T,tp_size>& mL,const SNupperTriangular<T,tp_size>& mU):
-    data_P(mP),
-    data_L(mL),
-    data_U(mU)
+    data_factors(std::make_shared<const Factors>(mP,mL,mU))
+{}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size>::SNplu(const Mpermutation<tp_size>& mP,const SNlowerTriangular<T,tp_size>& mL,const SNupperTriangular<T,tp_size>& mU,SNarena& arena):
+    data_factors(std::allocate_shared<Factors>(SNarenaAllocator<Factors>(arena),mP,mL,mU))
 {}
 
 // GETTER METHODS -----------------------
@@ -64,27 +265,513 @@ SNplu<T,tp_size>::SNplu(const Mpermutation<tp_size>& mP,const SNlowerTriangular<
 template <class T,unsigned int tp_size>
 const SNpermutation<T,tp_size> SNplu<T,tp_size>::getP() const
 {
-    return SNpermutation<T,tp_size>(data_P);
+    return SNpermutation<T,tp_size>(data_factors->P);
 }
 
 template <class T,unsigned int tp_size>
-const SNlowerTriangular<T,tp_size> SNplu<T,tp_size>::getL() const
+const SNlowerTriangular<T,tp_size>& SNplu<T,tp_size>::getL() const
 {
-    return data_L;
+    return data_factors->L;
 }
 
 
 template <class T,unsigned int tp_size>
-const SNupperTriangular<T,tp_size> SNplu<T,tp_size>::getU() const
+const SNupperTriangular<T,tp_size>& SNplu<T,tp_size>::getU() const
 {
-    return data_U;
+    return data_factors->U;
 }
 
 
 template <class T,unsigned int tp_size>
-const Mpermutation<tp_size> SNplu<T,tp_size>::getMpermutation() const
+const Mpermutation<tp_size>& SNplu<T,tp_size>::getMpermutation() const
+{
+    return data_factors->P;
+}
+
+template <class T,unsigned int tp_size>
+std::size_t SNplu<T,tp_size>::getMemoryUsage() const
+{
+    return sizeof(SNplu<T,tp_size>)+sizeof(Factors);
+}
+
+// SOLVING SYSTEMS -----------------------
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNplu<T,tp_size>::solve(const SNvector<T,tp_size>& b) const
+{
+    return solve(b,SNuseUnrolled<tp_size>());
+}
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNplu<T,tp_size>::solve(const SNvector<T,tp_size>& b,std::true_type) const
+{
+    SNvector<T,tp_size> x=data_factors->P.gather(b);
+    unrolledUnitLowerSolve<tp_size>(data_factors->L,x.data());
+    unrolledUpperSolve<tp_size>(data_factors->U,x.data());
+    return x;
+}
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNplu<T,tp_size>::solve(const SNvector<T,tp_size>& b,std::false_type) const
+{
+    const SNlowerTriangular<T,tp_size>& mL=data_factors->L;
+    const SNupperTriangular<T,tp_size>& mU=data_factors->U;
+
+    // P^{-1}b : the element 'image(j)' of b goes to the place 'j'.
+    SNvector<T,tp_size> x=data_factors->P.gather(b);
+
+    // Lz=y
+    for (m_num i=0;i<tp_size;++i)
+    {
+        T acc=x.get(i);
+        for (m_num k=0;k<i;++k)
+        {
+            acc-=mL.get(i,k)*x.get(k);
+        }
+        x.at(i)=acc/mL.get(i,i);
+    }
+
+    // Ux=z
+    for (unsigned int i=tp_size;i-- >0;)
+    {
+        T acc=x.get(i);
+        for (m_num k=i+1;k<tp_size;++k)
+        {
+            acc-=mU.get(i,k)*x.get(k);
+        }
+        x.at(i)=acc/mU.get(i,i);
+    }
+    return x;
+}
+
+template <class T,unsigned int tp_size>
+SNstatus SNplu<T,tp_size>::solve(const SNvector<T,tp_size>& b,SNvector<T,tp_size>& x) const
+{
+    if (getZeroPivotCount()!=0)
+    {
+        return SNstatus::singular;
+    }
+    x=solve(b);
+    return SNstatus::ok;
+}
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNplu<T,tp_size>::solveTransposed(const SNvector<T,tp_size>& b) const
+{
+    const SNlowerTriangular<T,tp_size>& mL=data_factors->L;
+    const SNupperTriangular<T,tp_size>& mU=data_factors->U;
+    SNvector<T,tp_size> w;
+
+    // U^Tz=b
+    for (m_num i=0;i<tp_size;++i)
+    {
+        T acc=b.get(i);
+        for (m_num k=0;k<i;++k)
+        {
+            acc-=mU.get(k,i)*w.get(k);
+        }
+        w.at(i)=acc/mU.get(i,i);
+    }
+
+    // L^Tw=z
+    for (unsigned int i=tp_size;i-- >0;)
+    {
+        T acc=w.get(i);
+        for (m_num k=i+1;k<tp_size;++k)
+        {
+            acc-=mL.get(k,i)*w.get(k);
+        }
+        w.at(i)=acc/mL.get(i,i);
+    }
+
+    // x=Pw : the element 'j' of w goes to the place 'image(j)'.
+    return data_factors->P.scatter(w);
+}
+
+template <class T,unsigned int tp_size>
+std::vector<SNvector<T,tp_size>> SNplu<T,tp_size>::solve_many(const std::vector<SNvector<T,tp_size>>& rhs,ThreadPool& pool) const
+{
+    std::vector<SNvector<T,tp_size>> solutions(rhs.size());
+    pool.parallelFor(0,rhs.size(),[this,&rhs,&solutions](unsigned int first,unsigned int last)
+        {
+            for (unsigned int k=first;k<last;++k)
+            {
+                solutions[k]=solve(rhs[k]);
+            }
+        });
+    return solutions;
+}
+
+// DIAGNOSTICS -----------------------
+
+template <class T,unsigned int tp_size>
+unsigned int SNplu<T,tp_size>::getZeroPivotCount() const
+{
+    unsigned int count=0;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        if (data_factors->U.get(i,i)==0)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <class T,unsigned int tp_size>
+T SNplu<T,tp_size>::getPivotGrowth(const SNgeneric<T,tp_size>& A) const
+{
+    T max_U=0;
+    T max_A=0;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<tp_size;++j)
+        {
+            max_A=std::max(max_A,T(std::abs(A.get(i,j))));
+            if (j>=i)
+            {
+                max_U=std::max(max_U,T(std::abs(data_factors->U.get(i,j))));
+            }
+        }
+    }
+    return max_U/max_A;
+}
+
+template <class T,unsigned int tp_size>
+T SNplu<T,tp_size>::estimateInverseNorm1() const
+{
+    if (getZeroPivotCount()!=0)
+    {
+        return std::numeric_limits<T>::infinity();
+    }
+
+    auto norm1=[](const SNvector<T,tp_size>& v)
+    {
+        T norm=0;
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            norm+=std::abs(v.get(i));
+        }
+        return norm;
+    };
+
+    // Hager : maximize the convex function x -> |A^{-1}x|_1 on the
+    // unit ball of the norm 1, going from vertex to vertex.
+    SNvector<T,tp_size> x;
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        x.at(i)=T(1)/tp_size;
+    }
+    T estimate=0;
+    for (unsigned int iteration=0;iteration<5;++iteration)
+    {
+        auto y=solve(x);
+        const T new_estimate=norm1(y);
+        if (iteration>0 and new_estimate<=estimate)
+        {
+            break;
+        }
+        estimate=new_estimate;
+
+        SNvector<T,tp_size> sign;
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            sign.at(i)= (y.get(i)>=0) ? 1 : -1;
+        }
+        auto z=solveTransposed(sign);
+        unsigned int j_max=0;
+        T z_x=0;
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            z_x+=z.get(i)*x.get(i);
+            if (std::abs(z.get(i))>std::abs(z.get(j_max)))
+            {
+                j_max=i;
+            }
+        }
+        if (iteration>0 and std::abs(z.get(j_max))<=z_x)
+        {
+            break;
+        }
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            x.at(i)=0;
+        }
+        x.at(j_max)=1;
+    }
+
+    // Higham : an alternating vector catches the cases where the
+    // iterations are stuck in a local maximum.
+    for (unsigned int i=0;i<tp_size;++i)
+    {
+        const T sign= (i%2==0) ? 1 : -1;
+        x.at(i)= (tp_size>1) ? sign*(1+T(i)/(tp_size-1)) : 1;
+    }
+    const T alternative=2*norm1(solve(x))/(3*tp_size);
+    return std::max(estimate,alternative);
+}
+
+template <class T,unsigned int tp_size>
+T SNplu<T,tp_size>::estimateCondition1(const SNgeneric<T,tp_size>& A) const
+{
+    T norm_A=0;
+    for (m_num j=0;j<tp_size;++j)
+    {
+        T sum=0;
+        for (m_num i=0;i<tp_size;++i)
+        {
+            sum+=std::abs(A.get(i,j));
+        }
+        norm_A=std::max(norm_A,sum);
+    }
+    return norm_A*estimateInverseNorm1();
+}
+
+// DETERMINANT -----------------------
+
+template <class T,unsigned int tp_size>
+T SNplu<T,tp_size>::determinant() const
+{
+    T det=data_factors->P.signature();
+    for (m_num i=0;i<tp_size;++i)
+    {
+        det*=data_factors->U.get(i,i);
+    }
+    return det;
+}
+
+template <class T,unsigned int tp_size>
+T SNplu<T,tp_size>::logAbsDeterminant(int& sign) const
+{
+    sign=data_factors->P.signature();
+    T log_det=0;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        const T u=data_factors->U.get(i,i);
+        if (u==0)
+        {
+            sign=0;
+        }
+        else if (u<0)
+        {
+            sign=-sign;
+        }
+        log_det+=std::log(std::abs(u));
+    }
+    return log_det;
+}
+
+// INVERSE -----------------------
+
+template <class T,unsigned int tp_size>
+SNmatrix<T,tp_size> SNplu<T,tp_size>::inverse() const
+{
+    return inverse(std::allocator<T>());
+}
+
+template <class T,unsigned int tp_size>
+SNmatrix<T,tp_size> SNplu<T,tp_size>::inverse(SNarena& arena) const
+{
+    return inverse(SNarenaAllocator<T>(arena));
+}
+
+template <class T,unsigned int tp_size>
+template <class Allocator>
+SNmatrix<T,tp_size> SNplu<T,tp_size>::inverse(const Allocator& alloc) const
+
+    // 'x', 'lower' and 'upper' are column major.
+
+{
+    explicitInverseWarning("Warning : computing an explicit inverse. Are you sure that 'solve' is not enough ?");
+
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<unsigned int> IndexAllocator;
+    const unsigned int block=16;
+    const unsigned int n=tp_size;
+    std::vector<T,Allocator> lower(n*n,T(0),alloc);
+    std::vector<T,Allocator> upper(n*n,T(0),alloc);
+    for (unsigned int j=0;j<n;++j)
+    {
+        for (unsigned int i=0;i<n;++i)
+        {
+            lower[j*n+i]= (i>j) ? data_factors->L.get(i,j) : 0;
+            upper[j*n+i]= (i<=j) ? data_factors->U.get(i,j) : 0;
+        }
+    }
+
+    // P^{-1}e_j is the vector with 1 on the line 'first[j]'.
+    std::vector<T,Allocator> x(n*n,T(0),alloc);
+    std::vector<unsigned int,IndexAllocator> first(n,0,IndexAllocator(alloc));
+    for (unsigned int i=0;i<n;++i)
+    {
+        const unsigned int j=data_factors->P.image(i);
+        x[j*n+i]=1;
+        first[j]=i;
+    }
+
+    for (unsigned int j_begin=0;j_begin<n;j_begin+=block)
+    {
+        const unsigned int j_end=std::min(n,j_begin+block);
+
+        // Lz=P^{-1}e_j (the diagonal of L is 1)
+        for (unsigned int k=0;k<n;++k)
+        {
+            const T* l_k=&lower[k*n];
+            for (unsigned int j=j_begin;j<j_end;++j)
+            {
+                if (k<first[j])
+                {
+                    continue;
+                }
+                T* x_j=&x[j*n];
+                const T x_kj=x_j[k];
+                for (unsigned int i=k+1;i<n;++i)
+                {
+                    x_j[i]-=l_k[i]*x_kj;
+                }
+            }
+        }
+
+        // Ux=z
+        for (unsigned int k=n;k-- >0;)
+        {
+            const T* u_k=&upper[k*n];
+            for (unsigned int j=j_begin;j<j_end;++j)
+            {
+                T* x_j=&x[j*n];
+                x_j[k]/=u_k[k];
+                const T x_kj=x_j[k];
+                for (unsigned int i=0;i<k;++i)
+                {
+                    x_j[i]-=u_k[i]*x_kj;
+                }
+            }
+        }
+    }
+
+    SNmatrix<T,tp_size> inv;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<tp_size;++j)
+        {
+            inv.at(i,j)=x[j*n+i];
+        }
+    }
+    return inv;
+}
+
+// REFACTORIZATION -----------------------
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNplu<T,tp_size>::refactor(const SNmatrix<T,tp_size>& A,T threshold) const
+{
+    return refactor(A,threshold,std::allocator<T>(),nullptr);
+}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNplu<T,tp_size>::refactor(const SNmatrix<T,tp_size>& A,SNarena& arena,T threshold) const
+{
+    return refactor(A,threshold,SNarenaAllocator<T>(arena),&arena);
+}
+
+template <class T,unsigned int tp_size>
+template <class Allocator>
+SNplu<T,tp_size> SNplu<T,tp_size>::refactor(const SNmatrix<T,tp_size>& A,T threshold,const Allocator& alloc,SNarena* arena) const
+
+    // 'lu' is column major and contains L under the diagonal
+    // and U on and over the diagonal.
+
+{
+    std::vector<T,Allocator> lu(tp_size*tp_size,T(0),alloc);
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            lu[j*tp_size+i]=A.get(data_factors->P.image(i),j);
+        }
+    }
+
+    for (unsigned int c=0;c<tp_size;++c)
+    {
+        T* col=&lu[c*tp_size];
+        T max_val=0;
+        for (unsigned int l=c;l<tp_size;++l)
+        {
+            max_val=std::max(max_val,T(std::abs(col[l])));
+        }
+        if (max_val==0)     // a column full of zero's, as in getPLU
+        {
+            continue;
+        }
+        if (col[c]==0 or std::abs(col[c])<threshold*max_val)
+        {
+            return arena ? A.getPLU(*arena) : A.getPLU();
+        }
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            col[l]/=col[c];
+        }
+        for (unsigned int j=c+1;j<tp_size;++j)
+        {
+            T* target=&lu[j*tp_size];
+            const T u_cj=target[c];
+            for (unsigned int l=c+1;l<tp_size;++l)
+            {
+                target[l]-=col[l]*u_cj;
+            }
+        }
+    }
+
+    SNlowerTriangular<T,tp_size> mL(1);
+    SNupperTriangular<T,tp_size> mU;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<i;++j)
+        {
+            mL.at(i,j)=lu[j*tp_size+i];
+        }
+        for (m_num j=i;j<tp_size;++j)
+        {
+            mU.at(i,j)=lu[j*tp_size+i];
+        }
+    }
+    if (arena)
+    {
+        return SNplu<T,tp_size>(data_factors->P,mL,mU,*arena);
+    }
+    return SNplu<T,tp_size>(data_factors->P,mL,mU);
+}
+
+// CONSTRUCTION FROM A COMPACT LU -----------------------
+
+/**
+ * @brief Build a `SNplu` from the result of a "LAPACK-like" elimination.
+ *
+ * \param pivots at step \f$ c \f$ the line \f$ c \f$ was swapped with
+ *              the line `pivots[c]` (\f$ \geq c \f$).
+ * \param element a function such that `element(i,j)` returns the element
+ *              \f$ (i,j) \f$ of the matrix containing L under the diagonal
+ *              and U on and over the diagonal (the diagonal of L being 1).
+ *
+ * The permutation is the product \f$ \tau_0\tau_1\ldots \f$ of the
+ * transpositions, as in `SNmatrix::getPLU`.
+ * */
+template <class T,unsigned int tp_size,class F>
+SNplu<T,tp_size> pluFromCompactLU(const std::array<unsigned int,tp_size>& pivots,F element)
 {
-    return  data_P;
+    SNlowerTriangular<T,tp_size> mL(1);
+    SNupperTriangular<T,tp_size> mU;
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<i;++j)
+        {
+            mL.at(i,j)=element(i,j);
+        }
+        for (m_num j=i;j<tp_size;++j)
+        {
+            mU.at(i,j)=element(i,j);
+        }
+    }
+    return SNplu<T,tp_size>(MpivotSequence<tp_size>(pivots).toMpermutation(),mL,mU);
 }
 
 #endif
@@ -0,0 +1,270 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNPLUCACHE_H__113018__
+#define __SNPLUCACHE_H__113018__
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "SNplu.h"
+#include "SNmatrices/SNmatrix.h"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief Remember the PLU decompositions already computed.
+*
+* When the same matrix comes back (the same Crank-Nicolson operator at each
+* time step, for example), the decomposition is not computed again.
+*
+* There are two ways to recognize a matrix :
+* - by its content : `getPLU(A)` computes a hash of the elements of `A`. The
+*   matrix is recorded with its decomposition, so that two different
+*   matrices with the same hash are not confused.
+* - by a key given by the user : `getPLU(key,A)` trusts the key and does not
+*   look at `A` when the key is already known. This is cheaper (no hash,
+*   no copy of `A`) but you are responsible of the key.
+*
+* The decompositions are returned as `std::shared_ptr<const SNplu>` : an
+* evicted decomposition remains valid as long as someone uses it.
+*
+* The memory used by the recorded objects is bounded by the budget given to
+* the constructor. When it is exceeded, the least recently used entries
+* are removed.
+*
+* All the member functions can be called from many threads at the same time.
+**/
+template <class T,unsigned int tp_size>
+class SNpluCache
+{
+    private :
+        class Entry
+        {
+            public :
+                std::string key;
+                std::shared_ptr<const SNplu<T,tp_size>> plu;
+                std::shared_ptr<const SNmatrix<T,tp_size>> matrix;  // empty for user keys
+                std::size_t bytes;
+        };
+
+        const std::size_t data_budget;
+        std::size_t data_used;
+        unsigned int data_hits;
+        unsigned int data_misses;
+
+        std::list<Entry> lru;     // the most recently used at the front
+        std::unordered_map<std::string,typename std::list<Entry>::iterator> entries;
+        mutable std::mutex mutex;
+
+        /** 
+         * Look for the key. On success, the entry becomes the most recent. 
+         * If `compare` is true, the recorded matrix has to be equal to `A`.
+         * */
+        std::shared_ptr<const SNplu<T,tp_size>> find(const std::string& key,const SNmatrix<T,tp_size>& A,bool compare);
+        void insert(Entry entry);
+        void evict();
+    public :
+        /**
+         * @brief Create an empty cache using at most `memory_budget` bytes.
+         * */
+        explicit SNpluCache(std::size_t memory_budget);
+
+        /**
+         * @brief Return the PLU decomposition of `A`, recognized by its
+         * content.
+         * */
+        std::shared_ptr<const SNplu<T,tp_size>> getPLU(const SNmatrix<T,tp_size>& A);
+
+        /**
+         * @brief Return the decomposition recorded for `key`. If there are
+         * none, compute the decomposition of `A` and record it for `key`.
+         * */
+        std::shared_ptr<const SNplu<T,tp_size>> getPLU(const std::string& key,const SNmatrix<T,tp_size>& A);
+
+        /** remove all the entries. */
+        void clear();
+
+        unsigned int getHits() const;
+        unsigned int getMisses() const;
+        /** return the number of recorded decompositions */
+        unsigned int getSize() const;
+        /** return the memory (in bytes) used by the recorded objects. */
+        std::size_t getMemoryUsage() const;
+};
+
+/**
+ * @brief A hash of the elements of the matrix.
+ * */
+template <class T,unsigned int tp_size>
+std::size_t contentHash(const SNgeneric<T,tp_size>& A)
+{
+    std::hash<T> hasher;
+    std::size_t h=tp_size;
+    for (m_num j=0;j<tp_size;++j)
+    {
+        for (m_num i=0;i<tp_size;++i)
+        {
+            h^=hasher(A.get(i,j))+0x9e3779b9+(h<<6)+(h>>2);
+        }
+    }
+    return h;
+}
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+SNpluCache<T,tp_size>::SNpluCache(std::size_t memory_budget):
+    data_budget(memory_budget),
+    data_used(0),
+    data_hits(0),
+    data_misses(0)
+{}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+unsigned int SNpluCache<T,tp_size>::getHits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return data_hits;
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNpluCache<T,tp_size>::getMisses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return data_misses;
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNpluCache<T,tp_size>::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+template <class T,unsigned int tp_size>
+std::size_t SNpluCache<T,tp_size>::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return data_used;
+}
+
+// LOOKUP -----------------------
+
+template <class T,unsigned int tp_size>
+std::shared_ptr<const SNplu<T,tp_size>> SNpluCache<T,tp_size>::find(const std::string& key,const SNmatrix<T,tp_size>& A,bool compare)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it=entries.find(key);
+    if (it==entries.end() or (compare and !(*it->second->matrix==A)))
+    {
+        ++data_misses;
+        return nullptr;
+    }
+    lru.splice(lru.begin(),lru,it->second);
+    ++data_hits;
+    return it->second->plu;
+}
+
+template <class T,unsigned int tp_size>
+void SNpluCache<T,tp_size>::insert(Entry entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entry.bytes>data_budget)
+    {
+        return;
+    }
+    auto it=entries.find(entry.key);
+    if (it!=entries.end())  // computed twice, or same hash but different matrix.
+    {
+        data_used-=it->second->bytes;
+        lru.erase(it->second);
+        entries.erase(it);
+    }
+    data_used+=entry.bytes;
+    lru.push_front(std::move(entry));
+    entries[lru.front().key]=lru.begin();
+    evict();
+}
+
+template <class T,unsigned int tp_size>
+void SNpluCache<T,tp_size>::evict()
+{
+    while (data_used>data_budget)
+    {
+        data_used-=lru.back().bytes;
+        entries.erase(lru.back().key);
+        lru.pop_back();
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNpluCache<T,tp_size>::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    entries.clear();
+    data_used=0;
+}
+
+template <class T,unsigned int tp_size>
+std::shared_ptr<const SNplu<T,tp_size>> SNpluCache<T,tp_size>::getPLU(const SNmatrix<T,tp_size>& A)
+{
+    const std::string key="content:"+std::to_string(contentHash(A));
+    auto plu=find(key,A,true);
+    if (plu)
+    {
+        return plu;
+    }
+    // The decomposition is computed without holding the lock.
+    Entry entry;
+    entry.key=key;
+    entry.plu=std::make_shared<const SNplu<T,tp_size>>(A.getPLU());
+    entry.matrix=std::make_shared<const SNmatrix<T,tp_size>>(A);
+    entry.bytes=entry.plu->getMemoryUsage()+sizeof(SNmatrix<T,tp_size>);
+    plu=entry.plu;
+    insert(std::move(entry));
+    return plu;
+}
+
+template <class T,unsigned int tp_size>
+std::shared_ptr<const SNplu<T,tp_size>> SNpluCache<T,tp_size>::getPLU(const std::string& key,const SNmatrix<T,tp_size>& A)
+{
+    auto plu=find("user:"+key,A,false);
+    if (plu)
+    {
+        return plu;
+    }
+    Entry entry;
+    entry.key="user:"+key;
+    entry.plu=std::make_shared<const SNplu<T,tp_size>>(A.getPLU());
+    entry.bytes=entry.plu->getMemoryUsage();
+    plu=entry.plu;
+    insert(std::move(entry));
+    return plu;
+}
+
+#endif
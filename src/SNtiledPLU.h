@@ -0,0 +1,300 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNTILEDPLU_H__101745__
+#define __SNTILEDPLU_H__101745__
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "SNplu.h"
+#include "TaskGraph.h"
+#include "ThreadPool.h"
+#include "SNmatrices/SNmatrix.h"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief PLU decomposition by tiles, scheduled as a graph of tasks.
+*
+* The matrix is cut in square tiles of size `tile_size` (the last ones
+* can be smaller). Let \f$ A_{ij} \f$ be the tiles. For each \f$ k \f$ :
+*
+* - *panel*(k) : the PLU decomposition (with partial pivoting) of the
+*   column of tiles \f$ A_{kk},A_{k+1,k},\ldots \f$.
+* - *solve*(k,j) for \f$ j>k \f$ : apply the line swaps of the panel to the
+*   column of tiles \f$ j \f$, and solve \f$ A_{kj}\leftarrow L_{kk}^{-1}A_{kj} \f$.
+* - *update*(k,i,j) for \f$ i,j>k \f$ : \f$ A_{ij}\leftarrow A_{ij}-A_{ik}A_{kj} \f$.
+*
+* Each of these is a task of a `TaskGraph`, with only the dependencies
+* that the mathematics requires. In particular the panel \f$ k+1 \f$ only
+* waits for the updates of the column \f$ k+1 \f$ : it runs while the
+* updates of the other columns are still going on ("look-ahead"). There
+* is no barrier between the columns, contrary to `getPLU(pool)`.
+*
+* The pivots are the ones of `getPLU()` : the larger element under the
+* diagonal of the whole column. The result is the same up to the rounding
+* (the operations are not done in the same order).
+*
+* ```
+* ThreadPool pool;
+* SNtiledPLU<double,500> tiled(A,pool,32);
+* auto plu=tiled.getPLU();
+* ```
+**/
+template <class T,unsigned int tp_size>
+class SNtiledPLU
+{
+    private :
+        const unsigned int data_tile;
+        const unsigned int data_n_tiles;
+        std::vector<T> data;            // column major, L and U together.
+        std::array<unsigned int,tp_size> data_pivots;
+
+        T& a(unsigned int i,unsigned int j);
+        T a(unsigned int i,unsigned int j) const;
+
+        /** first line (or column) of the tile number `k` */
+        unsigned int tileBegin(unsigned int k) const;
+        /** last line (or column) of the tile number `k`, plus one. */
+        unsigned int tileEnd(unsigned int k) const;
+
+        // The kernels. See the class documentation.
+        void panel(unsigned int k);
+        void solve(unsigned int k,unsigned int j);
+        void update(unsigned int k,unsigned int i,unsigned int j);
+
+        /** The swaps of the panels also apply on the columns at their left. */
+        void swapLeftColumns();
+
+        TaskGraph buildGraph();
+    public :
+        /**
+         * @brief Compute the PLU decomposition of `A` with the threads
+         * of `pool`.
+         * */
+        SNtiledPLU(const SNmatrix<T,tp_size>& A,ThreadPool& pool,unsigned int tile_size=32);
+
+        SNplu<T,tp_size> getPLU() const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+SNtiledPLU<T,tp_size>::SNtiledPLU(const SNmatrix<T,tp_size>& A,ThreadPool& pool,unsigned int tile_size):
+    data_tile(std::max(tile_size,1u)),
+    data_n_tiles((tp_size+data_tile-1)/data_tile),
+    data(tp_size*tp_size)
+{
+    for (m_num i=0;i<tp_size;++i)
+    {
+        for (m_num j=0;j<tp_size;++j)
+        {
+            a(i,j)=A.get(i,j);
+        }
+    }
+    buildGraph().run(pool);
+    swapLeftColumns();
+}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+T& SNtiledPLU<T,tp_size>::a(unsigned int i,unsigned int j)
+{
+    return data[j*tp_size+i];
+}
+
+template <class T,unsigned int tp_size>
+T SNtiledPLU<T,tp_size>::a(unsigned int i,unsigned int j) const
+{
+    return data[j*tp_size+i];
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNtiledPLU<T,tp_size>::tileBegin(unsigned int k) const
+{
+    return k*data_tile;
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNtiledPLU<T,tp_size>::tileEnd(unsigned int k) const
+{
+    return std::min(tp_size,(k+1)*data_tile);
+}
+
+template <class T,unsigned int tp_size>
+SNplu<T,tp_size> SNtiledPLU<T,tp_size>::getPLU() const
+{
+    return pluFromCompactLU<T,tp_size>(data_pivots,[this](unsigned int i,unsigned int j)
+        {
+            return a(i,j);
+        });
+}
+
+// THE TASKS -----------------------
+
+template <class T,unsigned int tp_size>
+void SNtiledPLU<T,tp_size>::panel(unsigned int k)
+{
+    const unsigned int c_end=tileEnd(k);
+    for (unsigned int c=tileBegin(k);c<c_end;++c)
+    {
+        unsigned int max_line=c;
+        T max_val=std::abs(a(c,c));
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            if (std::abs(a(l,c))>max_val)
+            {
+                max_val=std::abs(a(l,c));
+                max_line=l;
+            }
+        }
+        data_pivots[c]=max_line;
+        if (max_val==0)     // a column full of zero's
+        {
+            continue;
+        }
+        for (unsigned int j=tileBegin(k);j<c_end;++j)
+        {
+            std::swap(a(c,j),a(max_line,j));
+        }
+        const T pivot=a(c,c);
+        for (unsigned int l=c+1;l<tp_size;++l)
+        {
+            a(l,c)/=pivot;
+        }
+        for (unsigned int j=c+1;j<c_end;++j)
+        {
+            const T u_cj=a(c,j);
+            for (unsigned int l=c+1;l<tp_size;++l)
+            {
+                a(l,j)-=a(l,c)*u_cj;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNtiledPLU<T,tp_size>::solve(unsigned int k,unsigned int j)
+{
+    const unsigned int c_end=tileEnd(k);
+    for (unsigned int col=tileBegin(j);col<tileEnd(j);++col)
+    {
+        for (unsigned int c=tileBegin(k);c<c_end;++c)
+        {
+            std::swap(a(c,col),a(data_pivots[c],col));
+        }
+        // L_kk is lower triangular with 1 on the diagonal.
+        for (unsigned int c=tileBegin(k);c<c_end;++c)
+        {
+            const T u_c=a(c,col);
+            for (unsigned int l=c+1;l<c_end;++l)
+            {
+                a(l,col)-=a(l,c)*u_c;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNtiledPLU<T,tp_size>::update(unsigned int k,unsigned int i,unsigned int j)
+{
+    const unsigned int l_begin=tileBegin(i);
+    const unsigned int l_end=tileEnd(i);
+    for (unsigned int col=tileBegin(j);col<tileEnd(j);++col)
+    {
+        for (unsigned int c=tileBegin(k);c<tileEnd(k);++c)
+        {
+            const T u_c=a(c,col);
+            for (unsigned int l=l_begin;l<l_end;++l)
+            {
+                a(l,col)-=a(l,c)*u_c;
+            }
+        }
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNtiledPLU<T,tp_size>::swapLeftColumns()
+{
+    for (unsigned int k=1;k<data_n_tiles;++k)
+    {
+        for (unsigned int c=tileBegin(k);c<tileEnd(k);++c)
+        {
+            for (unsigned int col=0;col<tileBegin(k);++col)
+            {
+                std::swap(a(c,col),a(data_pivots[c],col));
+            }
+        }
+    }
+}
+
+// THE GRAPH -----------------------
+
+template <class T,unsigned int tp_size>
+TaskGraph SNtiledPLU<T,tp_size>::buildGraph()
+
+    // task_update[k][i][j] is stored at (k*nt+i)*nt+j.
+    // The tasks on the critical path (the panels and everything that
+    // updates the next panel) get the priority.
+
+{
+    const unsigned int nt=data_n_tiles;
+    TaskGraph graph;
+    std::vector<unsigned int> task_panel(nt);
+    std::vector<unsigned int> task_solve(nt*nt);
+    std::vector<unsigned int> task_update(nt*nt*nt);
+
+    for (unsigned int k=0;k<nt;++k)
+    {
+        task_panel[k]=graph.addTask([this,k] { panel(k); },true);
+        if (k>0)
+        {
+            for (unsigned int i=k;i<nt;++i)
+            {
+                graph.addDependency(task_update[((k-1)*nt+i)*nt+k],task_panel[k]);
+            }
+        }
+        for (unsigned int j=k+1;j<nt;++j)
+        {
+            const bool next=(j==k+1);
+            task_solve[k*nt+j]=graph.addTask([this,k,j] { solve(k,j); },next);
+            graph.addDependency(task_panel[k],task_solve[k*nt+j]);
+            if (k>0)
+            {
+                // the swaps touch the whole column under the line 'k'.
+                for (unsigned int i=k;i<nt;++i)
+                {
+                    graph.addDependency(task_update[((k-1)*nt+i)*nt+j],task_solve[k*nt+j]);
+                }
+            }
+            for (unsigned int i=k+1;i<nt;++i)
+            {
+                unsigned int t=graph.addTask([this,k,i,j] { update(k,i,j); },next);
+                task_update[(k*nt+i)*nt+j]=t;
+                graph.addDependency(task_solve[k*nt+j],t);
+            }
+        }
+    }
+    return graph;
+}
+
+#endif
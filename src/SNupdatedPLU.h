@@ -0,0 +1,317 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __SNUPDATEDPLU_H__143207__
+#define __SNUPDATEDPLU_H__143207__
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SNplu.h"
+#include "SNvector.h"
+#include "SNmatrices/SNmatrix.h"
+#include "exceptions/SNexceptions.cpp"
+
+
+// THE CLASS HEADER -----------------------------------------
+
+/**
+* @brief A PLU decomposition followed by low rank modifications of the matrix.
+*
+* Let \f$ A_0 \f$ be the last factorized matrix and
+* \f$ A=A_0+\sum_iu_iv_i^T=A_0+UV^T \f$ the current one. The
+* Sherman-Morrison-Woodbury formula gives
+* \f[
+*   A^{-1}b=y-Z(I+V^TZ)^{-1}V^Ty
+* \f]
+* with \f$ y=A_0^{-1}b \f$ and \f$ Z=A_0^{-1}U \f$.
+*
+* An update of rank \f$ k \f$ costs \f$ k \f$ solves with \f$ A_0 \f$ (the
+* columns of \f$ Z \f$), that is \f$ O(kn^2) \f$ instead of the
+* \f$ O(n^3) \f$ of a new decomposition. Each solve costs two more
+* \f$ O(kn) \f$ products.
+*
+* When the accumulated rank exceeds `max_rank`, the solves become more
+* expensive than a new factorization : the current matrix is factorized
+* again (reusing the permutation, see `SNplu::refactor`) and the
+* accumulated rank goes back to zero. The same happens when the small
+* matrix \f$ I+V^TZ \f$ is (numerically) singular : a pivot smaller than
+* \f$ \sqrt{\epsilon} \f$ times the size of the terms of \f$ I+V^TZ \f$ means
+* that more than half of the digits cancelled, and the Woodbury formula
+* would return garbage.
+*
+* ```
+* SNupdatedPLU<double,100> system(A);
+* system.update(u,v);        // now A+uv^T
+* auto x=system.solve(b);
+* ```
+**/
+template <class T,unsigned int tp_size>
+class SNupdatedPLU
+{
+    private :
+        const unsigned int data_max_rank;
+        SNmatrix<T,tp_size> data_A;     // the current matrix
+        SNplu<T,tp_size> data_plu;      // the decomposition of A_0
+        std::vector<SNvector<T,tp_size>> data_Z;
+        std::vector<SNvector<T,tp_size>> data_V;
+        std::vector<T> data_C;          // LU of I+V^TZ, row major, rank x rank
+        std::vector<unsigned int> data_C_pivots;
+        unsigned int data_refactor_count;
+
+        /** return false if I+V^TZ is numerically singular. */
+        bool factorCapacitance();
+        void refactor();
+    public :
+        /**
+         * @brief Factorize `A`. A new factorization is done when the rank
+         * of the accumulated modifications exceeds `max_rank`.
+         * */
+        explicit SNupdatedPLU(const SNmatrix<T,tp_size>& A,unsigned int max_rank=std::max(tp_size/8,1u));
+
+        /**
+         * @brief Replace the matrix \f$ A \f$ by \f$ A+uv^T \f$.
+         * */
+        void update(const SNvector<T,tp_size>& u,const SNvector<T,tp_size>& v);
+
+        /**
+         * @brief Replace the matrix \f$ A \f$ by \f$ A+\sum_iu_iv_i^T \f$.
+         *
+         * Throws `IncompatibleUpdateSizeException` if `U` and `V` do not
+         * have the same number of vectors.
+         * */
+        void update(const std::vector<SNvector<T,tp_size>>& U,const std::vector<SNvector<T,tp_size>>& V);
+
+        /** @brief Return the solution of \f$ Ax=b \f$ for the current matrix. */
+        SNvector<T,tp_size> solve(const SNvector<T,tp_size>& b) const;
+
+        /** return the rank of the modifications since the last factorization. */
+        unsigned int getRank() const;
+        /** return the number of factorizations done after the first one. */
+        unsigned int getRefactorCount() const;
+        /** return the current matrix. */
+        const SNmatrix<T,tp_size> getMatrix() const;
+};
+
+// CONSTRUCTORS -----------------------
+
+template <class T,unsigned int tp_size>
+SNupdatedPLU<T,tp_size>::SNupdatedPLU(const SNmatrix<T,tp_size>& A,unsigned int max_rank):
+    data_max_rank(max_rank),
+    data_A(A),
+    data_plu(A.getPLU()),
+    data_refactor_count(0)
+{}
+
+// GETTER METHODS -----------------------
+
+template <class T,unsigned int tp_size>
+unsigned int SNupdatedPLU<T,tp_size>::getRank() const
+{
+    return data_Z.size();
+}
+
+template <class T,unsigned int tp_size>
+unsigned int SNupdatedPLU<T,tp_size>::getRefactorCount() const
+{
+    return data_refactor_count;
+}
+
+template <class T,unsigned int tp_size>
+const SNmatrix<T,tp_size> SNupdatedPLU<T,tp_size>::getMatrix() const
+{
+    return data_A;
+}
+
+// UPDATES -----------------------
+
+template <class T,unsigned int tp_size>
+void SNupdatedPLU<T,tp_size>::refactor()
+{
+    data_plu=data_plu.refactor(data_A);
+    data_Z.clear();
+    data_V.clear();
+    data_C.clear();
+    data_C_pivots.clear();
+    ++data_refactor_count;
+}
+
+template <class T,unsigned int tp_size>
+bool SNupdatedPLU<T,tp_size>::factorCapacitance()
+
+    // Gaussian elimination with partial pivoting on the small matrix
+    // C=I+V^TZ. The pivots are the lines swapped at each step.
+    //
+    // The pivots are compared with 'scale', the max over the lines of the
+    // sum of the absolute values of the terms of C : when I+V^TZ is close
+    // to 0 (the usual failure of Woodbury), |C| itself is small and is not
+    // the right reference.
+
+{
+    const unsigned int k=data_Z.size();
+    data_C.assign(k*k,0);
+    data_C_pivots.assign(k,0);
+    T scale=0;
+    for (unsigned int i=0;i<k;++i)
+    {
+        T line_scale=0;
+        for (unsigned int j=0;j<k;++j)
+        {
+            T acc=(i==j) ? 1 : 0;
+            T magnitude=(i==j) ? 1 : 0;
+            for (unsigned int l=0;l<tp_size;++l)
+            {
+                const T term=data_V[i].get(l)*data_Z[j].get(l);
+                acc+=term;
+                magnitude+=std::abs(term);
+            }
+            data_C[i*k+j]=acc;
+            line_scale+=magnitude;
+        }
+        scale=std::max(scale,line_scale);
+    }
+    const T tolerance=std::sqrt(std::numeric_limits<T>::epsilon())*scale;
+    for (unsigned int c=0;c<k;++c)
+    {
+        unsigned int max_line=c;
+        for (unsigned int l=c+1;l<k;++l)
+        {
+            if (std::abs(data_C[l*k+c])>std::abs(data_C[max_line*k+c]))
+            {
+                max_line=l;
+            }
+        }
+        if (!(std::abs(data_C[max_line*k+c])>tolerance))
+        {
+            return false;
+        }
+        data_C_pivots[c]=max_line;
+        for (unsigned int j=0;j<k;++j)
+        {
+            std::swap(data_C[c*k+j],data_C[max_line*k+j]);
+        }
+        for (unsigned int l=c+1;l<k;++l)
+        {
+            data_C[l*k+c]/=data_C[c*k+c];
+            for (unsigned int j=c+1;j<k;++j)
+            {
+                data_C[l*k+j]-=data_C[l*k+c]*data_C[c*k+j];
+            }
+        }
+    }
+    return true;
+}
+
+template <class T,unsigned int tp_size>
+void SNupdatedPLU<T,tp_size>::update(const std::vector<SNvector<T,tp_size>>& U,const std::vector<SNvector<T,tp_size>>& V)
+{
+    if (U.size()!=V.size())
+    {
+        snThrow(IncompatibleUpdateSizeException(U.size(),V.size()));
+    }
+    for (unsigned int r=0;r<U.size();++r)
+    {
+        for (m_num i=0;i<tp_size;++i)
+        {
+            for (m_num j=0;j<tp_size;++j)
+            {
+                data_A.at(i,j)+=U[r].get(i)*V[r].get(j);
+            }
+        }
+    }
+    if (data_Z.size()+U.size()>data_max_rank)
+    {
+        refactor();
+        return;
+    }
+    for (unsigned int r=0;r<U.size();++r)
+    {
+        data_Z.push_back(data_plu.solve(U[r]));
+        data_V.push_back(V[r]);
+    }
+    if (!factorCapacitance())
+    {
+        refactor();
+    }
+}
+
+template <class T,unsigned int tp_size>
+void SNupdatedPLU<T,tp_size>::update(const SNvector<T,tp_size>& u,const SNvector<T,tp_size>& v)
+{
+    update(std::vector<SNvector<T,tp_size>>{u},std::vector<SNvector<T,tp_size>>{v});
+}
+
+// SOLVING SYSTEMS -----------------------
+
+template <class T,unsigned int tp_size>
+SNvector<T,tp_size> SNupdatedPLU<T,tp_size>::solve(const SNvector<T,tp_size>& b) const
+{
+    SNvector<T,tp_size> x=data_plu.solve(b);
+    const unsigned int k=data_Z.size();
+    if (k==0)
+    {
+        return x;
+    }
+
+    // w=C^{-1}V^Ty
+    std::vector<T> w(k);
+    for (unsigned int i=0;i<k;++i)
+    {
+        T acc=0;
+        for (unsigned int l=0;l<tp_size;++l)
+        {
+            acc+=data_V[i].get(l)*x.get(l);
+        }
+        w[i]=acc;
+    }
+    for (unsigned int c=0;c<k;++c)
+    {
+        std::swap(w[c],w[data_C_pivots[c]]);
+    }
+    for (unsigned int i=1;i<k;++i)
+    {
+        for (unsigned int j=0;j<i;++j)
+        {
+            w[i]-=data_C[i*k+j]*w[j];
+        }
+    }
+    for (unsigned int i=k;i-- >0;)
+    {
+        for (unsigned int j=i+1;j<k;++j)
+        {
+            w[i]-=data_C[i*k+j]*w[j];
+        }
+        w[i]/=data_C[i*k+i];
+    }
+
+    // x=y-Zw
+    for (unsigned int l=0;l<tp_size;++l)
+    {
+        T acc=x.get(l);
+        for (unsigned int j=0;j<k;++j)
+        {
+            acc-=data_Z[j].get(l)*w[j];
+        }
+        x.at(l)=acc;
+    }
+    return x;
+}
+
+#endif
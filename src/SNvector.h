@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <array>
 
+#include "SNmatrices/SNlayout.h"
+
 /*
 This is my vector type, designed for numerical computation. 
 */
@@ -32,22 +34,37 @@ class SNvector
 {
 
     private:
-        std::array<T,tp_size> data;
+        alignas(storageAlignment<T,tp_size>()) std::array<T,tp_size> data_elements;
     public :
         T get(unsigned int) const;
         T& at(unsigned int);
+
+        /** Unchecked access to the elements, for the inner loops (as `std::array::data`). */
+        T* data();
+        const T* data() const;
 };
 
 
 template <class T,unsigned int tp_size>
 T SNvector<T,tp_size>::get(unsigned int i) const
 {
-    return data.at(i);
+    return data_elements.at(i);
 }
 template <class T,unsigned int tp_size>
 T& SNvector<T,tp_size>::at(unsigned int i)
 {
-    return data.at(i);
+    return data_elements.at(i);
+}
+
+template <class T,unsigned int tp_size>
+T* SNvector<T,tp_size>::data()
+{
+    return data_elements.data();
+}
+template <class T,unsigned int tp_size>
+const T* SNvector<T,tp_size>::data() const
+{
+    return data_elements.data();
 }
 
 
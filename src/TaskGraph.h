@@ -0,0 +1,305 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __TASKGRAPH_H__093512__
+#define __TASKGRAPH_H__093512__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+/**
+* @brief A set of tasks with dependencies between them (a DAG), executed
+* by work-stealing.
+*
+* ```
+* TaskGraph graph;
+* unsigned int a=graph.addTask([]{ ... });
+* unsigned int b=graph.addTask([]{ ... });
+* graph.addDependency(a,b);      // 'b' starts after the end of 'a'
+* graph.run(pool);
+* ```
+*
+* Each worker has its own queue of ready tasks. When a task is done, the
+* successors that become ready are pushed in the queue of the worker that
+* finished it, and that worker continues with the last pushed one (so the
+* data is still in its cache). A worker whose queue is empty steals the
+* oldest task from the queue of another worker. A worker that finds
+* nothing to do after `spin_tries` attempts sleeps until a task becomes
+* ready : waiting for the critical path does not keep a core busy.
+*
+* There is no barrier : a task starts as soon as its own dependencies are
+* done, whatever the other tasks are doing.
+*
+* The tasks declared with `priority=true` are pushed after the other
+* ready successors, thus executed first. This is meant for the tasks on
+* the critical path (like the next panel of a LU decomposition).
+**/
+class TaskGraph
+{
+    private :
+        class Task
+        {
+            public :
+                std::function<void()> work;
+                std::vector<unsigned int> successors;
+                unsigned int n_dependencies;
+                bool priority;
+        };
+        class WorkQueue
+        {
+            public :
+                std::mutex mutex;
+                std::deque<unsigned int> ready;
+        };
+
+        std::vector<Task> tasks;
+
+        /** The number of attempts to pop or steal a task before sleeping. */
+        static constexpr unsigned int spin_tries=64;
+    public :
+        /**
+         * @brief Add a task to the graph and return its number.
+         * */
+        unsigned int addTask(std::function<void()> work,bool priority=false);
+
+        /**
+         * @brief The task `after` will not start before the end of the
+         * task `before`.
+         * */
+        void addDependency(unsigned int before,unsigned int after);
+
+        unsigned int getTaskCount() const;
+
+        /**
+         * @brief Execute all the tasks, using the threads of the pool and
+         * the calling thread.
+         *
+         * Return when all the tasks are done. If a task throws, no new task
+         * is started and the exception is re-thrown here.
+         *
+         * The graph is not modified : it can be run again.
+         * */
+        void run(ThreadPool& pool) const;
+};
+
+// BUILDING THE GRAPH -----------------------
+
+inline unsigned int TaskGraph::addTask(std::function<void()> work,bool priority)
+{
+    Task task;
+    task.work=std::move(work);
+    task.n_dependencies=0;
+    task.priority=priority;
+    tasks.push_back(std::move(task));
+    return tasks.size()-1;
+}
+
+inline void TaskGraph::addDependency(unsigned int before,unsigned int after)
+{
+    tasks.at(before).successors.push_back(after);
+    ++tasks.at(after).n_dependencies;
+}
+
+inline unsigned int TaskGraph::getTaskCount() const
+{
+    return tasks.size();
+}
+
+// EXECUTION -----------------------
+
+inline void TaskGraph::run(ThreadPool& pool) const
+{
+    const unsigned int n_tasks=tasks.size();
+    const unsigned int n_workers=pool.getThreadCount()+1;
+
+    std::vector<std::atomic<unsigned int>> remaining(n_tasks);
+    std::vector<WorkQueue> queues(n_workers);
+    std::atomic<unsigned int> done(0);
+    std::atomic<bool> failed(false);
+    std::atomic<unsigned int> n_ready(0);       // pushed and not yet popped
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    unsigned int next_queue=0;
+    for (unsigned int t=0;t<n_tasks;++t)
+    {
+        remaining[t]=tasks[t].n_dependencies;
+        if (tasks[t].n_dependencies==0)
+        {
+            queues[next_queue].ready.push_back(t);
+            next_queue=(next_queue+1)%n_workers;
+            ++n_ready;
+        }
+    }
+
+    // Taking 'sleep_mutex' before notifying : a worker that has just seen
+    // nothing to do under that mutex is already waiting, and is woken up.
+    auto notify=[&](bool all)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        if (all)
+        {
+            wake.notify_all();
+        }
+        else
+        {
+            wake.notify_one();
+        }
+    };
+
+    auto sleep=[&]()
+    {
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock,[&]{ return n_ready>0 or done==n_tasks or failed; });
+    };
+
+    auto pop=[&](unsigned int w,unsigned int& t)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queues[w].mutex);
+            if (!queues[w].ready.empty())
+            {
+                t=queues[w].ready.back();
+                queues[w].ready.pop_back();
+                --n_ready;
+                return true;
+            }
+        }
+        for (unsigned int k=1;k<n_workers;++k)      // steal
+        {
+            WorkQueue& victim=queues[(w+k)%n_workers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.ready.empty())
+            {
+                t=victim.ready.front();
+                victim.ready.pop_front();
+                --n_ready;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto release=[&](unsigned int w,unsigned int t)
+    {
+        std::vector<unsigned int> urgent;
+        unsigned int n_new=0;
+        {
+            std::lock_guard<std::mutex> lock(queues[w].mutex);
+            for (unsigned int s:tasks[t].successors)
+            {
+                if (--remaining[s]==0)
+                {
+                    if (tasks[s].priority)
+                    {
+                        urgent.push_back(s);
+                    }
+                    else
+                    {
+                        queues[w].ready.push_back(s);
+                    }
+                    ++n_new;
+                }
+            }
+            for (unsigned int s:urgent)
+            {
+                queues[w].ready.push_back(s);
+            }
+            n_ready+=n_new;
+        }
+        for (unsigned int k=0;k<n_new;++k)
+        {
+            notify(false);
+        }
+    };
+
+    auto worker=[&](unsigned int w)
+    {
+        unsigned int tries=0;
+        while (done<n_tasks and !failed)
+        {
+            unsigned int t;
+            if (!pop(w,t))
+            {
+                if (++tries<spin_tries)
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    tries=0;
+                    sleep();
+                }
+                continue;
+            }
+            tries=0;
+#ifdef SN_NO_EXCEPTIONS
+            tasks[t].work();
+#else
+            try
+            {
+                tasks[t].work();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                {
+                    error=std::current_exception();
+                }
+                failed=true;
+                notify(true);
+                return;
+            }
+#endif
+            release(w,t);
+            if (++done==n_tasks)
+            {
+                notify(true);
+            }
+        }
+    };
+
+    pool.parallelFor(0,n_workers,[&worker](unsigned int first,unsigned int last)
+        {
+            for (unsigned int w=first;w<last;++w)
+            {
+                worker(w);
+            }
+        });
+#ifndef SN_NO_EXCEPTIONS
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+
+#endif
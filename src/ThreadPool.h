@@ -0,0 +1,265 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __THREADPOOL_H__172203__
+#define __THREADPOOL_H__172203__
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "exceptions/SNexceptions.cpp"
+
+/**
+* @brief A fixed set of threads to which one gives tasks.
+*
+* The threads are created once (in the constructor) and reused for every
+* task, so that the cost of creating threads is not paid at each column
+* of a PLU decomposition.
+*
+* ```
+* ThreadPool pool(8);
+* pool.parallelFor(0,1000,[&](unsigned int first,unsigned int last)
+*   {
+*       for (unsigned int k=first;k<last;++k) { ... }
+*   });
+* ```
+*
+* The thread calling `parallelFor` works too : it treats the first chunk and,
+* while waiting for the other ones, it executes the tasks that are still
+* in the queue. Thus `parallelFor` can be called from a task of the same pool
+* without deadlock.
+*
+* The functions are defined in this header (and `inline`) so that using
+* the pool does not require to link one more object file.
+**/
+class ThreadPool
+{
+    private :
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable cv_task;
+        bool stopping;
+
+        /** The loop executed by each worker : wait for a task, run it. */
+        void workerLoop();
+
+        /**
+         * Execute one task of the queue if there is one.
+         * Return false if the queue was empty.
+         * */
+        bool runPendingTask();
+    public :
+        /**
+         * @brief Create a pool of `n` threads.
+         *
+         * By default, as many threads as the hardware supports.
+         * */
+        explicit ThreadPool(unsigned int n=std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)=delete;
+        ThreadPool& operator=(const ThreadPool&)=delete;
+
+        /** return the number of threads in the pool (the caller not included) */
+        unsigned int getThreadCount() const;
+
+        /**
+         * @brief Add a task in the queue.
+         *
+         * The task should not throw : an exception escaping a task
+         * submitted this way terminates the program.
+         * Use `parallelFor` if you need the exceptions.
+         * */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Call `f(first,last)` on chunks of `[begin,end)`, in parallel.
+         *
+         * The interval is split in at most `getThreadCount()+1` chunks of
+         * (almost) the same size. The function returns when all the chunks
+         * are done. If some calls throw, the first exception is re-thrown
+         * here (after all the chunks are done).
+         * */
+        template <class F>
+        void parallelFor(unsigned int begin,unsigned int end,F f);
+};
+
+// CONSTRUCTORS -----------------------
+
+inline ThreadPool::ThreadPool(unsigned int n):
+    stopping(false)
+{
+    n=std::max(n,1u);
+    for (unsigned int k=0;k<n;++k)
+    {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping=true;
+    }
+    cv_task.notify_all();
+    for (auto& worker:workers)
+    {
+        worker.join();
+    }
+}
+
+// GETTER METHODS -----------------------
+
+inline unsigned int ThreadPool::getThreadCount() const
+{
+    return workers.size();
+}
+
+// TASKS -----------------------
+
+inline void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_task.wait(lock,[this] { return stopping or !tasks.empty(); });
+            if (tasks.empty())  // thus 'stopping'
+            {
+                return;
+            }
+            task=std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+inline bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+        {
+            return false;
+        }
+        task=std::move(tasks.front());
+        tasks.pop();
+    }
+    task();
+    return true;
+}
+
+inline void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    cv_task.notify_one();
+}
+
+template <class F>
+void ThreadPool::parallelFor(unsigned int begin,unsigned int end,F f)
+{
+    if (end<=begin)
+    {
+        return;
+    }
+    const unsigned int length=end-begin;
+    const unsigned int n_chunks=std::min(length,getThreadCount()+1);
+
+    // The state shared by the chunks. It lives on this stack frame, which
+    // is fine because we do not return before all the chunks are done.
+    std::mutex done_mutex;
+    std::condition_variable cv_done;
+    unsigned int remaining=n_chunks-1;
+    std::exception_ptr error;
+
+    auto chunk_bound=[=](unsigned int k)
+    {
+        return begin+(length*k)/n_chunks;
+    };
+    auto run_chunk=[&](unsigned int k)
+    {
+#ifdef SN_NO_EXCEPTIONS
+        f(chunk_bound(k),chunk_bound(k+1));
+#else
+        try
+        {
+            f(chunk_bound(k),chunk_bound(k+1));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (!error)
+            {
+                error=std::current_exception();
+            }
+        }
+#endif
+    };
+
+    for (unsigned int k=1;k<n_chunks;++k)
+    {
+        submit([&,k]
+            {
+                run_chunk(k);
+                std::lock_guard<std::mutex> lock(done_mutex);
+                --remaining;
+                cv_done.notify_one();
+            });
+    }
+    run_chunk(0);
+
+    // Help the pool while our chunks are not done.
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            if (remaining==0)
+            {
+                break;
+            }
+        }
+        if (!runPendingTask())
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            cv_done.wait(lock,[&] { return remaining==0; });
+            break;
+        }
+    }
+#ifndef SN_NO_EXCEPTIONS
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+
+#endif
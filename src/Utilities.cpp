@@ -16,6 +16,8 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <atomic>
+
 #include "Utilities.h"
 
 // cppcheck-suppress unusedFunction
@@ -38,3 +40,13 @@ void tooGenericWarning(const std::string& message)
 {
     std::cout<<message<<std::endl;
 }
+
+// cppcheck-suppress unusedFunction
+void explicitInverseWarning(const char* message)
+{
+    static std::atomic<bool> already_printed(false);
+    if (!already_printed.exchange(true))
+    {
+        std::cout<<message<<std::endl;
+    }
+}
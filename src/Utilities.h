@@ -107,4 +107,20 @@ void debug_value_print(const std::string& text, const T& v)
  * */
 void tooGenericWarning(const std::string& message);
 
+/**
+ * \brief Display a warning the first time an explicit inverse is computed.
+ *
+ * \param message The message to be displayed.
+ *
+ * Solving \f$ Ax=b \f$ with the PLU decomposition is cheaper and more
+ * accurate than computing \f$ A^{-1}b \f$. The explicit inverse is only
+ * useful when one really needs its elements (small blocks of a
+ * preconditioner, for example).
+ *
+ * The message is printed once : the inverses are often computed in loops.
+ *
+ * \see `SNplu::inverse`
+ * */
+void explicitInverseWarning(const char* message);
+
 #endif
@@ -19,25 +19,69 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef __EXCEPTIONS_H__095622__
 #define __EXCEPTIONS_H__095622__
 
+#include <cstdio>
+#include <cstdlib>
 #include <exception>
+#include <iostream>
 #include <string>
 
+/*
+The library can be compiled without exceptions (`-fno-exceptions`, or
+`-DSN_NO_EXCEPTIONS`). The errors are then reported by printing the message
+of the exception that would have been thrown, and aborting.
+
+The library never writes `throw` : it calls `snThrow`.
+*/
+#if !defined(SN_NO_EXCEPTIONS) and !defined(__cpp_exceptions) and !defined(__EXCEPTIONS)
+#define SN_NO_EXCEPTIONS
+#endif
+
+#if defined(__GNUC__)
+#define SN_COLD __attribute__((noinline,cold))
+#else
+#define SN_COLD
+#endif
+
+/**
+* @brief Throw `e` ; abort with its message when the exceptions are disabled.
+*
+* This is not inlined : the checks of the inner loops only contain a
+* comparison and a call.
+**/
+template <class E>
+[[noreturn]] SN_COLD void snThrow(const E& e)
+{
+#ifdef SN_NO_EXCEPTIONS
+    std::cerr<<e.what()<<std::endl;
+    std::abort();
+#else
+    throw e;
+#endif
+}
+
+/**
+* @brief The result of the functions that can fail at run time for
+* mathematical reasons, and report it without exception.
+**/
+enum class SNstatus
+{
+    ok,
+    singular        // the matrix is not invertible (a zero pivot)
+};
+
 /** 
  *
 * @brief When trying to perform operation with matrices with
 * incompatible sizes.
 *
-* ```
-* SNlowerTriangular<int,4> A;
-* SNmatrix<double,2> B;
-* bool a=(A==B);  //throws
-* ```
-*
+* When the sizes are template parameters the check is done at compile
+* time (`checkSizeCompatibility`) :
 * ```
 * SNmatrix<double,2> A;
 * SNmatrix<double,3> B;
-* auto C=A*B;  //throws
+* auto C=A*B;  // does not compile
 * ```
+* This exception remains for the sizes that are only known at run time.
 *
 * */
 class IncompatibleMatrixSizeException : public std::exception
@@ -46,26 +90,24 @@ class IncompatibleMatrixSizeException : public std::exception
         unsigned int size1;
         unsigned int size2;
 
-        std::string _msg;
+        char _msg[96];
 
-        std::string message(const unsigned int size1, const unsigned int size2) const
+        void message(const unsigned int size1, const unsigned int size2)
         {
-            std::string s_s1=std::to_string(size1);
-            std::string s_s2=std::to_string(size2);
-
-            return "First matrix has size "+s_s1+" while second matrix has size "+s_s2;
+            std::snprintf(_msg,sizeof(_msg),"First matrix has size %u while second matrix has size %u",size1,size2);
         };
 
     public: 
         IncompatibleMatrixSizeException(const unsigned int s1, const unsigned int s2): 
             size1(s1),
-            size2(s2),
-            _msg( message(size1,size2) )
-        {}
+            size2(s2)
+        {
+            message(size1,size2);
+        }
         // cppcheck-suppress    unusedFunction
         virtual const char* what() const throw()
         {
-            return _msg.c_str();
+            return _msg;
         }
 };
 
@@ -145,23 +187,21 @@ class OutOfRangeColumnNumber : public std::exception
 class SNoutOfRangeException : public std::exception
 {
     private :
-        std::string _msg;
-        std::string message(const unsigned int i,const unsigned int j,const unsigned int size) const 
+        // not a std::string : no allocation when the exception is created.
+        char _msg[96];
+        void message(const unsigned int i,const unsigned int j,const unsigned int size)
         {
-            std::string s_line=std::to_string(i);
-            std::string s_col=std::to_string(j);
-            std::string s_size=std::to_string(size);
-
-            return "Attempt to access element ("+s_line+" , "+s_col+" ) while the matrix has size "+s_size;
+            std::snprintf(_msg,sizeof(_msg),"Attempt to access element (%u , %u ) while the matrix has size %u",i,j,size);
         };
 
     public: 
-        SNoutOfRangeException(const unsigned int i, const unsigned int j,const unsigned int s): 
-            _msg(message(i,j,s))
-    {}
+        SNoutOfRangeException(const unsigned int i, const unsigned int j,const unsigned int s)
+    {
+        message(i,j,s);
+    }
         virtual const char* what() const throw()
         {
-            return _msg.c_str();
+            return _msg;
         }
 };
 
@@ -179,23 +219,21 @@ class PermutationIdexoutOfRangeException : public std::exception
 {
 
     private :
-        std::string _msg;
+        char _msg[96];
 
-        std::string message(const unsigned int index, const unsigned int size) const
+        void message(const unsigned int index, const unsigned int size)
         {
-            std::string s_index=std::to_string(index);
-            std::string s_size=std::to_string(size);
-
-            return "Attempt to access element ("+s_index+" while the I am a permutation of integers from 0 to "+s_size;
+            std::snprintf(_msg,sizeof(_msg),"Attempt to access element (%u while the I am a permutation of integers from 0 to %u",index,size);
         };
 
     public: 
-        PermutationIdexoutOfRangeException(const unsigned int index, const unsigned int size): 
-            _msg(message(index,size))
-    {}
+        PermutationIdexoutOfRangeException(const unsigned int index, const unsigned int size)
+    {
+        message(index,size);
+    }
         virtual const char* what() const throw()
         {
-            return _msg.c_str();
+            return _msg;
         }
 };
 
@@ -237,27 +275,155 @@ class ProbablyNotWhatYouWantException : public std::exception
         }
 };
 
-class NegativeMatrixElementNumberException : public std::exception
+/** 
+ * @brief When a batch of systems receives a number of right hand sides
+ * that is not the number of matrices.
+ *
+ * ```
+ * SNbatchPLU<double,4> batch(matrices);    // 10 matrices
+ * batch.solve(rhs);                        // 9 vectors : throws
+ * ```
+ * */
+class IncompatibleBatchSizeException : public std::exception
 {
     private :
         std::string _msg;
 
-        std::string message(const int n)
+        std::string message(const unsigned int count, const unsigned int requested) const
         {
-            std::string s_num=std::to_string(n);
-            return "Trying to access line or column with negative number : "+s_num;
+            std::string s_count=std::to_string(count);
+            std::string s_requested=std::to_string(requested);
+
+            return "The batch contains "+s_count+" systems while "+s_requested+" were given";
         };
 
     public: 
-        explicit NegativeMatrixElementNumberException(const int n): 
-            _msg(message(n))
-    {}
+        IncompatibleBatchSizeException(const unsigned int count, const unsigned int requested): 
+            _msg(message(count,requested))
+        {}
         virtual const char* what() const throw()
         {
             return _msg.c_str();
         }
 };
 
+/** 
+* @brief When asking for a matrix that is not in the batch.
+*
+* ```
+* SNbatchPLU<double,4> batch(matrices);    // 10 matrices
+* batch.getPLU(10);                        // throws
+* ```
+* */
+class BatchIndexOutOfRangeException : public std::exception
+{
+    private :
+        char _msg[96];
+        void message(const unsigned int k,const unsigned int count)
+        {
+            std::snprintf(_msg,sizeof(_msg),"Attempt to access the system %u while the batch contains %u systems",k,count);
+        };
+
+    public: 
+        BatchIndexOutOfRangeException(const unsigned int k,const unsigned int count)
+    {
+        message(k,count);
+    }
+        virtual const char* what() const throw()
+        {
+            return _msg;
+        }
+};
+
+/** 
+ * @brief When a low rank update receives two lists of vectors
+ * of different lengths.
+ *
+ * ```
+ * system.update(U,V);      // 3 vectors u_i and 2 vectors v_i : throws
+ * ```
+ * */
+class IncompatibleUpdateSizeException : public std::exception
+{
+    private :
+        std::string _msg;
+
+        std::string message(const unsigned int u_count, const unsigned int v_count) const
+        {
+            std::string s_u=std::to_string(u_count);
+            std::string s_v=std::to_string(v_count);
+
+            return "The update has "+s_u+" vectors u_i but "+s_v+" vectors v_i";
+        };
+
+    public: 
+        IncompatibleUpdateSizeException(const unsigned int u_count, const unsigned int v_count): 
+            _msg(message(u_count,v_count))
+        {}
+        virtual const char* what() const throw()
+        {
+            return _msg.c_str();
+        }
+};
+
+/** 
+ * @brief When an operation on block views receives blocks whose
+ * extents do not fit.
+ *
+ * ```
+ * auto C=A.getBlockView(0,0,2,3);
+ * auto B=A.getBlockView(2,2,3,3);
+ * C.addScaled(1,B);        // 2x3 and 3x3 : throws
+ * ```
+ * */
+class IncompatibleBlockSizeException : public std::exception
+{
+    private :
+        std::string _msg;
+
+        std::string message(const unsigned int l1,const unsigned int c1,const unsigned int l2,const unsigned int c2) const
+        {
+            return "First block is "+std::to_string(l1)+"x"+std::to_string(c1)+" while second block is "+std::to_string(l2)+"x"+std::to_string(c2);
+        };
+
+    public: 
+        IncompatibleBlockSizeException(const unsigned int l1,const unsigned int c1,const unsigned int l2,const unsigned int c2): 
+            _msg(message(l1,c1,l2,c2))
+        {}
+        virtual const char* what() const throw()
+        {
+            return _msg.c_str();
+        }
+};
+
+/** 
+* @brief When trying to access an element out of a rectangular matrix.
+*
+* ```
+* SNrectangular<double,4,2> R;
+* R.at(1,2);     // throws
+* ```
+* */
+class RectangularOutOfRangeException : public std::exception
+{
+    private :
+        char _msg[112];
+        void message(const unsigned int i,const unsigned int j,const unsigned int lines,const unsigned int columns)
+        {
+            std::snprintf(_msg,sizeof(_msg),"Attempt to access element (%u , %u ) while the matrix is %ux%u",i,j,lines,columns);
+        };
+
+    public: 
+        RectangularOutOfRangeException(const unsigned int i,const unsigned int j,const unsigned int lines,const unsigned int columns)
+    {
+        message(i,j,lines,columns);
+    }
+        virtual const char* what() const throw()
+        {
+            return _msg;
+        }
+};
+
 /** 
  * @brief This exception is trowed on the top of the functions that
  * should not be used because they are about to be removed.
@@ -53,6 +53,20 @@ function unit_tests
     launch_test "repeat_function_unit_tests"
     launch_test "sn_multiplication_unit_tests"
     launch_test "multiplication_unit_tests"
+    launch_test "batch_unit_tests"
+    launch_test "thread_pool_unit_tests"
+    launch_test "tiled_plu_unit_tests"
+    launch_test "plu_cache_unit_tests"
+    launch_test "updated_plu_unit_tests"
+    launch_test "mixed_precision_unit_tests"
+    launch_test "indirect_plu_unit_tests"
+    launch_test "sn_view_unit_tests"
+    launch_test "block_view_unit_tests"
+    launch_test "arena_unit_tests"
+    launch_test "no_exceptions_tests"
+    launch_test "constexpr_plu_unit_tests"
+    launch_test "unrolled_unit_tests"
+    launch_test "rectangular_unit_tests"
 }
 
 
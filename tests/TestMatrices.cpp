@@ -235,6 +235,22 @@ auto testMatrixL()
 }
 
 
+/** A 'random' but reproducible matrix, large enough for the parallel tests. */
+template <unsigned int s>
+SNmatrix<double,s> pseudoRandomMatrix(unsigned int seed=17)
+{
+    SNmatrix<double,s> A;
+    for (m_num i=0;i<s;++i)
+    {
+        for (m_num j=0;j<s;++j)
+        {
+            seed=(seed*1103515245+12345)%2147483648u;
+            A.at(i,j)=double(seed%2000)/100-10;
+        }
+    }
+    return A;
+}
+
 template <class T,unsigned int tp_size>
 class AutoTestMatrix
 {
@@ -0,0 +1,265 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNarena.h"
+#include "../src/SNplu.h"
+#include "TestMatrices.cpp"
+
+// THE ALLOCATION COUNTER -----------------------------------
+
+// Every heap allocation of this program goes through here : the plain,
+// array and nothrow forms of 'new', and their aligned versions (used by
+// the 64-byte aligned matrices since the tests are built with -faligned-new).
+// The matching forms of 'delete' release with 'free'.
+std::atomic<unsigned long> allocation_count(0);
+
+void* countedAllocate(std::size_t size,std::size_t alignment) noexcept
+{
+    ++allocation_count;
+    size=size ? size : 1;
+    if (alignment<=alignof(std::max_align_t))
+    {
+        return std::malloc(size);
+    }
+    void* p=nullptr;
+    if (posix_memalign(&p,alignment,size)!=0)
+    {
+        return nullptr;
+    }
+    return p;
+}
+
+void* countedAllocateOrThrow(std::size_t size,std::size_t alignment)
+{
+    void* p=countedAllocate(size,alignment);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(std::size_t size)
+{
+    return countedAllocateOrThrow(size,alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocateOrThrow(size,alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size,const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size,alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size,const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size,alignof(std::max_align_t));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p,std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p,const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size,std::align_val_t alignment)
+{
+    return countedAllocateOrThrow(size,static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size,std::align_val_t alignment)
+{
+    return countedAllocateOrThrow(size,static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size,std::align_val_t alignment,const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size,static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size,std::align_val_t alignment,const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size,static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p,std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p,std::size_t,std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,std::size_t,std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p,std::align_val_t,const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p,std::align_val_t,const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+#endif
+
+class ArenaTest : public CppUnit::TestCase
+{
+    private :
+        void test_arena()
+        {
+            echo_function_test("test_arena");
+            SNarena arena(256);
+            void* a=arena.allocate(10,1);
+            void* b=arena.allocate(8,64);
+            CPPUNIT_ASSERT(reinterpret_cast<std::uintptr_t>(b)%64==0);
+            CPPUNIT_ASSERT(b!=a);
+            CPPUNIT_ASSERT(arena.getCapacity()==256);
+
+            echo_single_test("growth, then one block after reset");
+            arena.allocate(1000,8);
+            CPPUNIT_ASSERT(arena.getCapacity()>256);
+            const std::size_t used=arena.getUsed();
+            arena.reset();
+            CPPUNIT_ASSERT(arena.getUsed()==0);
+            CPPUNIT_ASSERT(arena.getCapacity()>=used);
+
+            echo_single_test("allocator");
+            const unsigned long before=allocation_count;
+            {
+                std::vector<double,SNarenaAllocator<double>> v(50,1.,SNarenaAllocator<double>(arena));
+                CPPUNIT_ASSERT(v[49]==1);
+            }
+            CPPUNIT_ASSERT(allocation_count==before);
+
+            echo_single_test("the counter sees the aligned allocations");
+            const unsigned long before_aligned=allocation_count;
+            {
+                std::vector<SNmatrix<double,20>> Ms(3);
+                CPPUNIT_ASSERT(alignof(SNmatrix<double,20>)==64);
+                CPPUNIT_ASSERT(reinterpret_cast<std::uintptr_t>(&Ms[1])%64==0);
+            }
+            std::unique_ptr<double[]> values(new double[7]);
+            CPPUNIT_ASSERT(allocation_count==before_aligned+2);
+        }
+        void test_steady_state()
+        {
+            echo_function_test("test_steady_state");
+            double epsilon(0.0000001);
+            auto A=pseudoRandomMatrix<20>();
+            auto B=A;
+            B.at(3,4)+=0.01;
+            SNvector<double,20> b;
+            for (unsigned int i=0;i<20;++i)
+            {
+                b.at(i)=i;
+            }
+            const auto reference=A.getPLU();
+            const auto x_ref=reference.solve(b);
+            const auto inv_ref=reference.inverse();
+
+            SNarena arena;
+            for (unsigned int step=0;step<5;++step)
+            {
+                const unsigned long before=allocation_count;
+                arena.reset();
+                {
+                    auto plu=A.getPLU(arena);
+                    auto x=plu.solve(b);
+                    auto next=plu.refactor(B,arena);
+                    auto inv=plu.inverse(arena);
+
+                    CPPUNIT_ASSERT(plu.getU()==reference.getU());
+                    CPPUNIT_ASSERT(inv.isNumericallyEqual(inv_ref,epsilon));
+                    CPPUNIT_ASSERT(next.getMpermutation()==plu.getMpermutation());
+                    for (unsigned int i=0;i<20;++i)
+                    {
+                        CPPUNIT_ASSERT(x.get(i)==x_ref.get(i));
+                    }
+                }
+                // the first steps make the arena grow.
+                if (step>=2)
+                {
+                    CPPUNIT_ASSERT(allocation_count==before);
+                }
+            }
+        }
+    public:
+        void runTest()
+        {
+            test_arena();
+            test_steady_state();
+        }
+};
+
+int main ()
+{
+    std::cout<<"ArenaTest"<<std::endl;
+    ArenaTest arena_test;
+    arena_test.runTest();
+}
@@ -0,0 +1,239 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNbatchPLU.h"
+#include "TestMatrices.cpp"
+
+class batchTest : public CppUnit::TestCase
+{
+    private :
+        std::vector<SNmatrix<double,4>> some_matrices()
+        {
+            std::vector<SNmatrix<double,4>> matrices;
+            matrices.push_back(testMatrixE());
+            matrices.push_back(testMatrixF());
+            matrices.push_back(testMatrixH());
+            matrices.push_back(testMatrixI());
+            matrices.push_back(SNmatrix<double,4>(testMatrixG()));
+            return matrices;
+        }
+        void compare_with_getPLU()
+        {
+            echo_function_test("compare_with_getPLU");
+
+            auto matrices=some_matrices();
+            SNbatchPLU<double,4> batch(matrices);
+            CPPUNIT_ASSERT(batch.getCount()==matrices.size());
+
+            double epsilon(0.0000001);
+            for (unsigned int k=0;k<matrices.size();++k)
+            {
+                echo_single_test("One more matrix");
+                auto plu=matrices[k].getPLU();
+                auto bplu=batch.getPLU(k);
+
+                CPPUNIT_ASSERT(!batch.isSingular(k));
+                CPPUNIT_ASSERT(bplu.getMpermutation()==plu.getMpermutation());
+                CPPUNIT_ASSERT(bplu.getL().isNumericallyEqual(plu.getL(),epsilon));
+                CPPUNIT_ASSERT(bplu.getU().isNumericallyEqual(plu.getU(),epsilon));
+            }
+            CPPUNIT_ASSERT_THROW(batch.getPLU(matrices.size()),BatchIndexOutOfRangeException);
+            try
+            {
+                batch.getPLU(7);
+            }
+            catch (const BatchIndexOutOfRangeException& e)
+            {
+                CPPUNIT_ASSERT(std::string(e.what())=="Attempt to access the system 7 while the batch contains 5 systems");
+            }
+        }
+        // The sizes up to 8 use the unrolled kernels, the larger ones the loops.
+        template <unsigned int s>
+        void compare_size()
+        {
+            echo_single_test("size "+std::to_string(s));
+            double epsilon(0.0000001);
+            std::vector<SNmatrix<double,s>> matrices;
+            std::vector<SNvector<double,s>> rhs(9);
+            for (unsigned int k=0;k<9;++k)
+            {
+                matrices.push_back(pseudoRandomMatrix<s>(k+1));
+                for (unsigned int i=0;i<s;++i)
+                {
+                    rhs[k].at(i)=i+k;
+                }
+            }
+            SNbatchPLU<double,s> batch(matrices);
+            auto solutions=batch.solve(rhs);
+            for (unsigned int k=0;k<9;++k)
+            {
+                auto plu=matrices[k].getPLU();
+                auto bplu=batch.getPLU(k);
+                CPPUNIT_ASSERT(bplu.getMpermutation()==plu.getMpermutation());
+                CPPUNIT_ASSERT(bplu.getL().isNumericallyEqual(plu.getL(),epsilon));
+                CPPUNIT_ASSERT(bplu.getU().isNumericallyEqual(plu.getU(),epsilon));
+                auto x=plu.solve(rhs[k]);
+                for (unsigned int i=0;i<s;++i)
+                {
+                    CPPUNIT_ASSERT(std::abs(solutions[k].get(i)-x.get(i))<epsilon);
+                }
+            }
+        }
+        void sizes_tests()
+        {
+            echo_function_test("sizes_tests");
+            compare_size<1>();
+            compare_size<2>();
+            compare_size<5>();
+            compare_size<8>();
+            compare_size<9>();
+            compare_size<13>();
+        }
+        void solve_tests()
+        {
+            echo_function_test("solve_tests");
+
+            auto matrices=some_matrices();
+            SNbatchPLU<double,4> batch(matrices);
+
+            std::vector<SNvector<double,4>> rhs(matrices.size());
+            for (unsigned int k=0;k<matrices.size();++k)
+            {
+                for (unsigned int i=0;i<4;++i)
+                {
+                    rhs[k].at(i)=i+k+1;
+                }
+            }
+            auto solutions=batch.solve(rhs);
+            std::vector<SNvector<double,4>> checked(matrices.size());
+            CPPUNIT_ASSERT(batch.solve(rhs,checked)==SNstatus::ok);
+
+            echo_single_test("A*x=b");
+            for (unsigned int k=0;k<matrices.size();++k)
+            {
+                for (unsigned int i=0;i<4;++i)
+                {
+                    double acc=0;
+                    for (unsigned int j=0;j<4;++j)
+                    {
+                        acc+=matrices[k].get(i,j)*solutions[k].get(j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(acc-rhs[k].get(i))<0.0000001);
+                    CPPUNIT_ASSERT(checked[k].get(i)==solutions[k].get(i));
+                }
+            }
+
+            echo_single_test("wrong number of right hand sides");
+            rhs.pop_back();
+            CPPUNIT_ASSERT_THROW(batch.solve(rhs),IncompatibleBatchSizeException);
+        }
+        void singular_tests()
+        {
+            echo_function_test("singular_tests");
+
+            std::vector<SNmatrix<double,3>> matrices;
+            matrices.push_back(testMatrixB());
+            matrices.push_back(testMatrixA());
+            matrices.push_back(testMatrixC());
+            SNbatchPLU<double,3> batch(matrices);
+
+            CPPUNIT_ASSERT(!batch.isSingular(0));
+            CPPUNIT_ASSERT(batch.isSingular(1));
+            CPPUNIT_ASSERT(!batch.isSingular(2));
+
+            echo_single_test("the singular matrix does not disturb the others");
+            double epsilon(0.0000001);
+            auto plu=testMatrixC().getPLU();
+            CPPUNIT_ASSERT(batch.getPLU(2).getU().isNumericallyEqual(plu.getU(),epsilon));
+            auto bplu=batch.getPLU(1);
+            auto prod=bplu.getP()*bplu.getL()*bplu.getU();
+            CPPUNIT_ASSERT(prod.isNumericallyEqual(testMatrixA(),epsilon));
+
+            echo_single_test("the singular system is not solved");
+            std::vector<SNvector<double,3>> rhs(3);
+            for (unsigned int k=0;k<3;++k)
+            {
+                for (unsigned int i=0;i<3;++i)
+                {
+                    rhs[k].at(i)=i+1;
+                }
+            }
+            auto solutions=batch.solve(rhs);
+            for (unsigned int i=0;i<3;++i)
+            {
+                CPPUNIT_ASSERT(solutions[1].get(i)==0);
+            }
+            auto x0=testMatrixB().getPLU().solve(rhs[0]);
+            auto x2=plu.solve(rhs[2]);
+
+            std::vector<SNvector<double,3>> checked(3);
+            for (unsigned int i=0;i<3;++i)
+            {
+                checked[1].at(i)=-7;
+            }
+            CPPUNIT_ASSERT(batch.solve(rhs,checked)==SNstatus::singular);
+            for (unsigned int i=0;i<3;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(solutions[0].get(i)-x0.get(i))<epsilon);
+                CPPUNIT_ASSERT(std::abs(solutions[2].get(i)-x2.get(i))<epsilon);
+                CPPUNIT_ASSERT(checked[0].get(i)==solutions[0].get(i));
+                CPPUNIT_ASSERT(checked[1].get(i)==-7);
+                CPPUNIT_ASSERT(checked[2].get(i)==solutions[2].get(i));
+            }
+
+            std::vector<SNvector<double,3>> too_short(2);
+            CPPUNIT_ASSERT_THROW(batch.solve(rhs,too_short),IncompatibleBatchSizeException);
+        }
+        void inverse_tests()
+        {
+            echo_function_test("inverse_tests");
+            double epsilon(0.0000001);
+
+            auto matrices=some_matrices();
+            SNbatchPLU<double,4> batch(matrices);
+            auto inverses=batch.inverse();
+            CPPUNIT_ASSERT(inverses.size()==matrices.size());
+            for (unsigned int k=0;k<matrices.size();++k)
+            {
+                auto inv=matrices[k].getPLU().inverse();
+                CPPUNIT_ASSERT(inverses[k].isNumericallyEqual(inv,epsilon));
+            }
+        }
+    public:
+        void runTest()
+        {
+            compare_with_getPLU();
+            sizes_tests();
+            solve_tests();
+            singular_tests();
+            inverse_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"batchTest"<<std::endl;
+    batchTest batch_test;
+    batch_test.runTest();
+}
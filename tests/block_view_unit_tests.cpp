@@ -0,0 +1,226 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNmatrices/SNmatrix.h"
+#include "../src/SNplu.h"
+#include "TestMatrices.cpp"
+
+class BlockViewTest : public CppUnit::TestCase
+{
+    private :
+        double epsilon=0.0000001;
+
+        void test_access()
+        {
+            echo_function_test("test_access");
+            auto A=pseudoRandomMatrix<6>();
+            auto B=A.getBlockView(1,2,3,4);
+            CPPUNIT_ASSERT(B.getLines()==3);
+            CPPUNIT_ASSERT(B.get(2,3)==A.get(3,5));
+            B.at(0,0)=17;
+            CPPUNIT_ASSERT(A.get(1,2)==17);
+            auto C=B.getBlockView(1,1,2,2);
+            CPPUNIT_ASSERT(C.get(0,0)==A.get(2,3));
+
+            echo_single_test("out of range");
+            CPPUNIT_ASSERT_THROW(A.getBlockView(4,0,3,1),SNoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(B.at(3,0),SNoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(B.getBlockView(0,0,1,5),SNoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(B.addScaled(1,C),IncompatibleBlockSizeException);
+        }
+        void test_add_and_product()
+        {
+            echo_function_test("test_add_and_product");
+            auto A=pseudoRandomMatrix<8>(3);
+            const auto B=pseudoRandomMatrix<8>(5);
+            auto R=A;
+
+            echo_single_test("scaled add");
+            A.getBlockView(2,3,4,5).addScaled(2,B.getBlockView(0,0,4,5));
+            for (m_num i=0;i<8;++i)
+            {
+                for (m_num j=0;j<8;++j)
+                {
+                    bool inside= i>=2 and i<6 and j>=3;
+                    double expected= inside ? R.get(i,j)+2*B.get(i-2,j-3) : R.get(i,j);
+                    CPPUNIT_ASSERT(A.get(i,j)==expected);
+                }
+            }
+
+            echo_single_test("product into a block");
+            A=R;
+            // A(0:3,4:6) += -1 * B(1:3,2:5) * B(5:8,0:2)
+            A.getBlockView(0,4,3,2).multiplyAdd(-1,B.getBlockView(1,2,3,3),B.getBlockView(5,0,3,2));
+            for (m_num i=0;i<3;++i)
+            {
+                for (m_num j=0;j<2;++j)
+                {
+                    double expected=R.get(i,j+4);
+                    for (m_num k=0;k<3;++k)
+                    {
+                        expected-=B.get(1+i,2+k)*B.get(5+k,j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(A.get(i,j+4)-expected)<epsilon);
+                }
+            }
+            CPPUNIT_ASSERT(A.get(3,4)==R.get(3,4));
+        }
+        void test_triangular_solves()
+        {
+            echo_function_test("test_triangular_solves");
+            auto A=pseudoRandomMatrix<7>(11);
+            for (m_num i=0;i<7;++i)
+            {
+                A.at(i,i)+=10;      // well conditioned triangles
+            }
+            const auto B=pseudoRandomMatrix<7>(13);
+
+            // the triangles of A(0:4,0:4), the right hand sides in X(0:4,4:7)
+            auto T=A.getBlockView(0,0,4,4);
+            for (unsigned int unit=0;unit<2;++unit)
+            {
+                auto X=B;
+                auto RHS=X.getBlockView(0,4,4,3);
+                RHS.leftSolveLower(T,unit==1);
+                for (m_num i=0;i<4;++i)
+                {
+                    for (m_num j=0;j<3;++j)
+                    {
+                        // (L*X)(i,j)
+                        double acc= unit==1 ? RHS.get(i,j) : T.get(i,i)*RHS.get(i,j);
+                        for (m_num k=0;k<i;++k)
+                        {
+                            acc+=T.get(i,k)*RHS.get(k,j);
+                        }
+                        CPPUNIT_ASSERT(std::abs(acc-B.get(i,j+4))<epsilon);
+                    }
+                }
+            }
+
+            auto X=B;
+            auto RHS=X.getBlockView(0,4,4,3);
+            RHS.leftSolveUpper(T);
+            for (m_num i=0;i<4;++i)
+            {
+                for (m_num j=0;j<3;++j)
+                {
+                    double acc=0;
+                    for (m_num k=i;k<4;++k)
+                    {
+                        acc+=T.get(i,k)*RHS.get(k,j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(acc-B.get(i,j+4))<epsilon);
+                }
+            }
+
+            X=B;
+            auto LHS=X.getBlockView(4,0,3,4);
+            LHS.rightSolveUpper(T);
+            for (m_num i=0;i<3;++i)
+            {
+                for (m_num j=0;j<4;++j)
+                {
+                    double acc=0;
+                    for (m_num k=0;k<=j;++k)
+                    {
+                        acc+=LHS.get(i,k)*T.get(k,j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(acc-B.get(i+4,j))<epsilon);
+                }
+            }
+        }
+
+        /*
+        * A LU decomposition without pivoting, by blocks of 3, of a
+        * diagonally dominant matrix, entirely done in place with the
+        * block operations.
+        */
+        void test_blocked_lu()
+        {
+            echo_function_test("test_blocked_lu");
+            const unsigned int n=9;
+            auto A=pseudoRandomMatrix<n>(7);
+            for (m_num i=0;i<n;++i)
+            {
+                A.at(i,i)+=20;
+            }
+            auto LU=A;
+            const unsigned int nb=3;
+            for (unsigned int k=0;k<n;k+=nb)
+            {
+                // unblocked LU of the diagonal block
+                auto D=LU.getBlockView(k,k,nb,nb);
+                for (m_num c=0;c<nb;++c)
+                {
+                    for (m_num i=c+1;i<nb;++i)
+                    {
+                        D(i,c)/=D(c,c);
+                        for (m_num j=c+1;j<nb;++j)
+                        {
+                            D(i,j)-=D(i,c)*D(c,j);
+                        }
+                    }
+                }
+                const unsigned int rest=n-k-nb;
+                if (rest==0)
+                {
+                    break;
+                }
+                auto A12=LU.getBlockView(k,k+nb,nb,rest);
+                auto A21=LU.getBlockView(k+nb,k,rest,nb);
+                A12.leftSolveLower(D,true);
+                A21.rightSolveUpper(D);
+                LU.getBlockView(k+nb,k+nb,rest,rest).multiplyAdd(-1,A21,A12);
+            }
+
+            // The unblocked reference : L*U=A
+            for (m_num i=0;i<n;++i)
+            {
+                for (m_num j=0;j<n;++j)
+                {
+                    double acc= i<=j ? LU.get(i,j) : 0;
+                    for (m_num k=0;k<i and k<=j;++k)
+                    {
+                        acc+=LU.get(i,k)*LU.get(k,j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(acc-A.get(i,j))<epsilon);
+                }
+            }
+        }
+    public:
+        void runTest()
+        {
+            test_access();
+            test_add_and_product();
+            test_triangular_solves();
+            test_blocked_lu();
+        }
+};
+
+int main ()
+{
+    std::cout<<"BlockViewTest"<<std::endl;
+    BlockViewTest block_view_test;
+    block_view_test.runTest();
+}
@@ -0,0 +1,105 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNconstexprPLU.h"
+#include "TestMatrices.cpp"
+
+// COMPILE TIME ---------------------------------------
+
+//  2 1 1
+//  4 3 3
+//  8 7 9
+constexpr SNmatrix<double,3> constexpr_A(std::array<double,9>{{2,4,8,1,3,7,1,3,9}});
+constexpr SNconstexprPLU<double,3> constexpr_plu(constexpr_A);
+
+static_assert(m_num(2u)<3u,"m_num is constexpr");
+static_assert(constexpr_A(2,1)==7,"constexpr SNmatrix");
+static_assert(constexpr_plu.getMpermutation()[0]==2,"the first pivot is on the last line");
+static_assert(constexpr_plu.getLU()(0,0)==8,"the first pivot");
+static_assert(constexpr_plu.getLU()(1,0)==0.25,"a multiplier");
+
+// RUN TIME ---------------------------------------
+
+class ConstexprPluTest : public CppUnit::TestCase
+{
+    private :
+        template <unsigned int s>
+        void compare(const SNconstexprPLU<double,s>& lu,const SNmatrix<double,s>& A)
+        {
+            double epsilon(0.0000001);
+            auto plu=A.getPLU();
+            auto cplu=lu.getPLU();
+            CPPUNIT_ASSERT(lu.getMpermutation()==plu.getMpermutation());
+            CPPUNIT_ASSERT(cplu.getL().isNumericallyEqual(plu.getL(),epsilon));
+            CPPUNIT_ASSERT(cplu.getU().isNumericallyEqual(plu.getU(),epsilon));
+
+            SNvector<double,s> b;
+            for (unsigned int i=0;i<s;++i)
+            {
+                b.at(i)=double(i%5)-2;
+            }
+            auto x=lu.solve(b);
+            auto y=plu.solve(b);
+            for (unsigned int i=0;i<s;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(x.get(i)-y.get(i))<epsilon);
+            }
+        }
+        void compile_time_tests()
+        {
+            echo_function_test("compile_time_tests");
+            compare(constexpr_plu,constexpr_A);
+        }
+        void run_time_tests()
+        {
+            echo_function_test("run_time_tests");
+            auto E=testMatrixE();
+            compare(SNconstexprPLU<double,4>(E),E);
+            auto H=testMatrixH();
+            compare(SNconstexprPLU<double,4>(H),H);
+            auto R=pseudoRandomMatrix<12>();
+            compare(SNconstexprPLU<double,12>(R),R);
+        }
+        void layout_tests()
+        {
+            echo_function_test("layout_tests");
+            constexpr SNmatrix<double,3,RowMajor> B(std::array<double,9>{{2,4,8,1,3,7,1,3,9}});
+            static_assert(B(0,1)==1,"constexpr SNmatrix with RowMajor");
+            CPPUNIT_ASSERT(B.get(2,2)==9);
+            const SNconstexprPLU<double,3> lu(B);
+            CPPUNIT_ASSERT(lu.getLU()(0,0)==8);
+        }
+    public:
+        void runTest()
+        {
+            compile_time_tests();
+            run_time_tests();
+            layout_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"ConstexprPluTest"<<std::endl;
+    ConstexprPluTest constexpr_plu_test;
+    constexpr_plu_test.runTest();
+}
@@ -44,31 +44,26 @@ class ExceptionsTests : public CppUnit::TestCase
 
         void incompatible_matrix_size_test()
         {
-            SNlowerTriangular<int,4> A;
-            SNmatrix<double,2> B;
-
-            // std::cout<<  is in order to avoid the warning about 
-            // "equality comparison result unused"
-            // I do no know how to do better ...
-            CPPUNIT_ASSERT_THROW(std::cout<<(A==B),IncompatibleMatrixSizeException);
-
-            SNmatrix<double,2> C;
-            SNmatrix<double,3> D;
-            CPPUNIT_ASSERT_THROW(C*D,IncompatibleMatrixSizeException);
+            echo_function_test("incompatible_matrix_size_test");
+            // The sizes of 'SNmatrix<double,2>*SNmatrix<double,3>' are checked
+            // at compile time; the exception remains for the run time checks.
+            IncompatibleMatrixSizeException e(2,3);
+            std::string ans("First matrix has size 2 while second matrix has size 3");
+            CPPUNIT_ASSERT(e.what()==ans);
         }
 
         void error_message_test()
         {
             echo_function_test("error_message_test");
-            SNmatrix<double,2> C;
-            SNmatrix<double,3> D;
+            SNmatrix<double,3> A;
             try
             {
-                std::cout<<C*D;
+                A.get(1,5);
+                CPPUNIT_FAIL("SNoutOfRangeException expected");
             }
-            catch (IncompatibleMatrixSizeException& e)
+            catch (SNoutOfRangeException& e)
             {
-                std::string ans("First matrix has size 2 while second matrix has size 3");
+                std::string ans("Attempt to access element (1 , 5 ) while the matrix has size 3");
                 CPPUNIT_ASSERT(e.what()==ans);
             }
         };
@@ -102,6 +102,12 @@ class GaussTest : public CppUnit::TestCase
             auto B(A);
             A.lineMinusLine(2,A.getSNline(0));
             CPPUNIT_ASSERT( A.getSNline(2)==B.getSNline(2) );
+
+            // through a view : no copy of the line
+            A.lineMinusLine(2,A.getLineView(1));
+            CPPUNIT_ASSERT(A.get(2,0)==0);
+            CPPUNIT_ASSERT(A.get(2,1)==6);
+            CPPUNIT_ASSERT(A.get(2,2)==10);
         }
         void test_upper_triangular()
         {
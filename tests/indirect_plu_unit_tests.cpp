@@ -0,0 +1,86 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNindirectPLU.h"
+#include "TestMatrices.cpp"
+
+class IndirectPluTest : public CppUnit::TestCase
+{
+    private :
+        template <unsigned int s>
+        void compare(const SNmatrix<double,s>& A)
+        {
+            double epsilon(0.0000001);
+            auto plu=A.getPLU();
+            auto lu=A.getIndirectPLU();
+            auto iplu=lu.getPLU();
+            CPPUNIT_ASSERT(lu.getMpermutation()==plu.getMpermutation());
+            CPPUNIT_ASSERT(iplu.getL().isNumericallyEqual(plu.getL(),epsilon));
+            CPPUNIT_ASSERT(iplu.getU().isNumericallyEqual(plu.getU(),epsilon));
+
+            SNvector<double,s> b;
+            for (unsigned int i=0;i<s;++i)
+            {
+                b.at(i)=double(i%5)-2;
+            }
+            auto x=lu.solve(b);
+            auto y=plu.solve(b);
+            for (unsigned int i=0;i<s;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(x.get(i)-y.get(i))<epsilon);
+            }
+        }
+        void compare_with_getPLU()
+        {
+            echo_function_test("compare_with_getPLU");
+            compare(testMatrixE());
+            compare(testMatrixF());
+            compare(testMatrixH());
+            compare(testMatrixL());
+            compare(pseudoRandomMatrix<30>());
+        }
+        void zero_column_tests()
+        {
+            echo_function_test("zero_column_tests");
+            auto H=testMatrixH();
+            for (m_num i=0;i<4;++i)
+            {
+                H.at(i,3)=0;
+            }
+            auto iplu=H.getIndirectPLU().getPLU();
+            CPPUNIT_ASSERT(iplu.getU()==H.getPLU().getU());
+            CPPUNIT_ASSERT(iplu.getZeroPivotCount()==1);
+        }
+    public:
+        void runTest()
+        {
+            compare_with_getPLU();
+            zero_column_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"IndirectPluTest"<<std::endl;
+    IndirectPluTest indirect_plu_test;
+    indirect_plu_test.runTest();
+}
@@ -70,11 +70,26 @@ class mNumTest : public CppUnit::TestCase
             }
             CPPUNIT_ASSERT(w==ans_v);
         }
+        void zero_cost_tests()
+        {
+            echo_function_test("zero_cost_tests");
+            static_assert(std::is_trivially_copyable<m_num>::value,"trivially copyable");
+            static_assert(noexcept(m_num(3)),"noexcept construction");
+            constexpr m_num k(2u);
+            static_assert(k<3u and k>1 and unsigned(k)==2,"constexpr comparisons");
+            m_num m(1);
+            static_assert(noexcept(++m) and noexcept(m<k),"noexcept operators");
+            m_num n(5);
+            m.swap(n);
+            CPPUNIT_ASSERT(m==5);
+            CPPUNIT_ASSERT(n==1);
+        }
     public:
         void runTest()
         {
             increment_tests();
             loop_tests();
+            zero_cost_tests();
         }
 };
  
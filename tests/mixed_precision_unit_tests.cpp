@@ -0,0 +1,113 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNmixedPrecision.h"
+#include "TestMatrices.cpp"
+
+template <unsigned int s>
+SNvector<double,s> someVector(unsigned int k)
+{
+    SNvector<double,s> v;
+    for (unsigned int i=0;i<s;++i)
+    {
+        v.at(i)=double((i*7+k*3)%11)-5;
+    }
+    return v;
+}
+
+/** the max difference between 'x' and the solution given by the double PLU. */
+template <unsigned int s>
+double distanceToDouble(const SNmatrix<double,s>& A,const SNvector<double,s>& x,const SNvector<double,s>& b)
+{
+    auto y=A.getPLU().solve(b);
+    double dist=0;
+    for (unsigned int i=0;i<s;++i)
+    {
+        dist=std::max(dist,std::abs(x.get(i)-y.get(i)));
+    }
+    return dist;
+}
+
+class MixedPrecisionTest : public CppUnit::TestCase
+{
+    private :
+        void refinement_tests()
+        {
+            echo_function_test("refinement_tests");
+
+            // the kind of matrix of the finite differences : diagonally dominant
+            auto A=pseudoRandomMatrix<30>();
+            for (m_num i=0;i<30;++i)
+            {
+                A.at(i,i)+=300;
+            }
+            SNmixedPrecisionSolver<30> solver(A);
+            auto b=someVector<30>(2);
+
+            RefinementReport report;
+            auto x=solver.solve(b,report);
+            CPPUNIT_ASSERT(report.converged);
+            CPPUNIT_ASSERT(!report.fallback);
+            CPPUNIT_ASSERT(report.iterations>0);
+            CPPUNIT_ASSERT(distanceToDouble(A,x,b)<1e-13);
+
+            echo_single_test("without refinement, float is not enough");
+            SNmixedPrecisionSolver<30> lazy(A,0);
+            lazy.solve(b,report);
+            CPPUNIT_ASSERT(!report.converged);
+            CPPUNIT_ASSERT(report.fallback);
+        }
+        void fallback_tests()
+        {
+            echo_function_test("fallback_tests");
+
+            // the Hilbert matrix is too ill-conditioned for float.
+            SNmatrix<double,8> H;
+            for (m_num i=0;i<8;++i)
+            {
+                for (m_num j=0;j<8;++j)
+                {
+                    H.at(i,j)=1./(i+j+1);
+                }
+            }
+            SNmixedPrecisionSolver<8> solver(H);
+            auto b=someVector<8>(1);
+            RefinementReport report;
+            auto x=solver.solve(b,report);
+            CPPUNIT_ASSERT(!report.converged);
+            CPPUNIT_ASSERT(report.fallback);
+            CPPUNIT_ASSERT(distanceToDouble(H,x,b)==0);
+        }
+    public:
+        void runTest()
+        {
+            refinement_tests();
+            fallback_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"MixedPrecisionTest"<<std::endl;
+    MixedPrecisionTest mixed_precision_test;
+    mixed_precision_test.runTest();
+}
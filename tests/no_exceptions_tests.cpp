@@ -0,0 +1,93 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** 
+ * This test is compiled with `-fno-exceptions` : it checks that the library
+ * compiles in that mode and that the functions reporting their errors
+ * with `SNstatus` work there.
+ *
+ * It does not use cppunit (which needs the exceptions) : it returns a
+ * non-zero value on failure.
+ * */
+
+#include <cmath>
+#include <iostream>
+
+#include "../src/SNplu.h"
+
+#ifndef SN_NO_EXCEPTIONS
+#error "This test must be compiled with -fno-exceptions."
+#endif
+
+bool check(bool condition,const char* what)
+{
+    if (!condition)
+    {
+        std::cout<<"FAILED : "<<what<<std::endl;
+    }
+    return condition;
+}
+
+int main ()
+{
+    bool ok=true;
+
+    SNmatrix<double,3> A;
+    A.at(0,0)=2; A.at(0,1)=1; A.at(0,2)=1;
+    A.at(1,0)=4; A.at(1,1)=3; A.at(1,2)=3;
+    A.at(2,0)=8; A.at(2,1)=7; A.at(2,2)=9;
+
+    SNvector<double,3> b;
+    b.at(0)=4; b.at(1)=10; b.at(2)=24;
+
+    // the solution is (1,1,1)
+    auto plu=A.getPLU();
+    auto x=plu.solve(b);
+    for (m_num i=0;i<3;++i)
+    {
+        ok=check(std::abs(x.get(i)-1)<1e-12,"solve") and ok;
+    }
+
+    SNvector<double,3> y;
+    ok=check(plu.solve(b,y)==SNstatus::ok,"status of a regular matrix") and ok;
+    ok=check(std::abs(y.get(2)-1)<1e-12,"solve with status") and ok;
+
+    // singular : the last column is zero
+    SNmatrix<double,3> S(A);
+    for (m_num i=0;i<3;++i)
+    {
+        S.at(i,2)=0;
+    }
+    SNvector<double,3> z;
+    z.at(0)=7;
+    ok=check(S.getPLU().solve(b,z)==SNstatus::singular,"status of a singular matrix") and ok;
+    ok=check(z.get(0)==7,"x unchanged on failure") and ok;
+
+    // the views
+    auto line=A.getLineView(1);
+    ok=check(line[2]==3,"line view") and ok;
+    auto column=A.getColumnView(0);
+    column.scale(2);
+    ok=check(A.get(2,0)==16,"column view") and ok;
+
+    if (ok)
+    {
+        std::cout<<"No exceptions tests : ok"<<std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNpluCache.h"
+#include "TestMatrices.cpp"
+
+class pluCacheTest : public CppUnit::TestCase
+{
+    private :
+        // the memory needed to record 'n' matrices (by content)
+        std::size_t budget(unsigned int n)
+        {
+            return n*(SNmatrix<double,4>(1).getPLU().getMemoryUsage()+sizeof(SNmatrix<double,4>));
+        }
+        void content_tests()
+        {
+            echo_function_test("content_tests");
+            SNpluCache<double,4> cache(budget(10));
+
+            auto plu1=cache.getPLU(testMatrixE());
+            auto plu2=cache.getPLU(testMatrixE());
+            auto plu3=cache.getPLU(testMatrixF());
+
+            echo_single_test("same matrix : same decomposition");
+            CPPUNIT_ASSERT(plu1==plu2);
+            CPPUNIT_ASSERT(plu1!=plu3);
+            CPPUNIT_ASSERT(cache.getHits()==1);
+            CPPUNIT_ASSERT(cache.getMisses()==2);
+            CPPUNIT_ASSERT(cache.getSize()==2);
+            CPPUNIT_ASSERT(cache.getMemoryUsage()==budget(2));
+
+            echo_single_test("the decomposition is the right one");
+            CPPUNIT_ASSERT(plu3->getU()==testMatrixF().getPLU().getU());
+
+            echo_single_test("a small change is another matrix");
+            auto E=testMatrixE();
+            E.at(2,3)+=0.000001;
+            CPPUNIT_ASSERT(cache.getPLU(E)!=plu1);
+
+            cache.clear();
+            CPPUNIT_ASSERT(cache.getSize()==0);
+            CPPUNIT_ASSERT(cache.getMemoryUsage()==0);
+        }
+        void eviction_tests()
+        {
+            echo_function_test("eviction_tests");
+            SNpluCache<double,4> cache(budget(2));
+
+            auto pE=cache.getPLU(testMatrixE());
+            cache.getPLU(testMatrixF());
+            cache.getPLU(testMatrixE());       // now F is the least recently used
+            cache.getPLU(testMatrixH());       // evicts F
+            CPPUNIT_ASSERT(cache.getSize()==2);
+            CPPUNIT_ASSERT(cache.getMemoryUsage()<=budget(2));
+
+            unsigned int misses=cache.getMisses();
+            CPPUNIT_ASSERT(cache.getPLU(testMatrixE())==pE);
+            CPPUNIT_ASSERT(cache.getMisses()==misses);
+            cache.getPLU(testMatrixF());
+            CPPUNIT_ASSERT(cache.getMisses()==misses+1);
+
+            echo_single_test("too small budget : nothing recorded");
+            SNpluCache<double,4> tiny(10);
+            auto p=tiny.getPLU(testMatrixE());
+            CPPUNIT_ASSERT(p->getU()==testMatrixE().getPLU().getU());
+            CPPUNIT_ASSERT(tiny.getSize()==0);
+        }
+        void user_key_tests()
+        {
+            echo_function_test("user_key_tests");
+            SNpluCache<double,4> cache(budget(10));
+
+            auto p1=cache.getPLU("crank-nicolson",testMatrixE());
+            // the key is trusted : the matrix is not looked at.
+            auto p2=cache.getPLU("crank-nicolson",testMatrixF());
+            CPPUNIT_ASSERT(p1==p2);
+            CPPUNIT_ASSERT(p1->getU()==testMatrixE().getPLU().getU());
+
+            // keys and contents do not mix
+            CPPUNIT_ASSERT(cache.getPLU(testMatrixE())!=p1);
+        }
+        void threads_tests()
+        {
+            echo_function_test("threads_tests");
+            SNpluCache<double,4> cache(budget(3));
+            std::vector<std::thread> threads;
+            for (unsigned int t=0;t<4;++t)
+            {
+                threads.emplace_back([&cache,t]
+                    {
+                        for (unsigned int k=0;k<50;++k)
+                        {
+                            auto A=((k+t)%2==0) ? testMatrixE() : testMatrixI();
+                            auto plu=cache.getPLU(A);
+                            CPPUNIT_ASSERT(plu->getU()==A.getPLU().getU());
+                        }
+                    });
+            }
+            for (auto& thread:threads)
+            {
+                thread.join();
+            }
+            CPPUNIT_ASSERT(cache.getHits()+cache.getMisses()==200);
+            CPPUNIT_ASSERT(cache.getSize()==2);
+        }
+    public:
+        void runTest()
+        {
+            content_tests();
+            eviction_tests();
+            user_key_tests();
+            threads_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"pluCacheTest"<<std::endl;
+    pluCacheTest plu_cache_test;
+    plu_cache_test.runTest();
+}
@@ -16,6 +16,9 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <thread>
+#include <vector>
+
 #include <cppunit/TestCase.h>
 #include <cppunit/extensions/TypeInfoHelper.h>
 #include <cppunit/TestAssert.h>
@@ -53,6 +56,59 @@ void auto_test( const AutoTestMatrix<T,tp_size>& atm  )
     CPPUNIT_ASSERT(c_prod.isNumericallyEqual(atm.A,epsilon));
 }
 
+/** return true if `x` is a solution of `Ax=b` up to `epsilon`. */
+template <class T,unsigned int tp_size>
+bool isSolution(const SNmatrix<T,tp_size>& A,const SNvector<T,tp_size>& x,const SNvector<T,tp_size>& b,double epsilon)
+{
+    for (m_num i=0;i<tp_size;++i)
+    {
+        T acc=0;
+        for (m_num j=0;j<tp_size;++j)
+        {
+            acc+=A.get(i,j)*x.get(j);
+        }
+        if (std::abs(acc-b.get(i))>epsilon)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** return the exact value of the norm 1 of the inverse of the matrix. */
+template <class T,unsigned int tp_size>
+T exactInverseNorm1(const SNplu<T,tp_size>& plu)
+{
+    T norm=0;
+    for (unsigned int j=0;j<tp_size;++j)
+    {
+        SNvector<T,tp_size> e;
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            e.at(i)= (i==j) ? 1 : 0;
+        }
+        auto column=plu.solve(e);
+        T sum=0;
+        for (unsigned int i=0;i<tp_size;++i)
+        {
+            sum+=std::abs(column.get(i));
+        }
+        norm=std::max(norm,sum);
+    }
+    return norm;
+}
+
+template <unsigned int s>
+SNvector<double,s> someVector(unsigned int k)
+{
+    SNvector<double,s> b;
+    for (unsigned int i=0;i<s;++i)
+    {
+        b.at(i)=double(i*k%7)-2.5;
+    }
+    return b;
+}
+
 class pluTest : public CppUnit::TestCase
 {
     private :
@@ -144,11 +200,275 @@ class pluTest : public CppUnit::TestCase
             CPPUNIT_ASSERT(UL==ID);
             CPPUNIT_ASSERT(UU==mU);
         }
+        void solve_tests()
+        {
+            echo_function_test("solve_tests");
+            double epsilon(0.0000001);
+
+            auto L=testMatrixL();
+            auto b=someVector<5>(3);
+            CPPUNIT_ASSERT(isSolution(L,L.getPLU().solve(b),b,epsilon));
+
+            auto H=testMatrixH();
+            auto c=someVector<4>(5);
+            CPPUNIT_ASSERT(isSolution(H,H.getPLU().solve(c),c,epsilon));
+
+            auto A=pseudoRandomMatrix<30>();
+            auto d=someVector<30>(11);
+            CPPUNIT_ASSERT(isSolution(A,A.getPLU().solve(d),d,epsilon));
+        }
+        void concurrent_solve_tests()
+        {
+            echo_function_test("concurrent_solve_tests");
+            auto A=pseudoRandomMatrix<30>();
+            const auto plu=A.getPLU();
+
+            std::vector<SNvector<double,30>> rhs;
+            for (unsigned int k=0;k<50;++k)
+            {
+                rhs.push_back(someVector<30>(k));
+            }
+
+            echo_single_test("solve_many");
+            ThreadPool pool(4);
+            auto solutions=plu.solve_many(rhs,pool);
+            CPPUNIT_ASSERT(solutions.size()==rhs.size());
+            for (unsigned int k=0;k<rhs.size();++k)
+            {
+                auto x=plu.solve(rhs[k]);
+                for (unsigned int i=0;i<30;++i)
+                {
+                    CPPUNIT_ASSERT(solutions[k].get(i)==x.get(i));
+                }
+            }
+
+            echo_single_test("solve from many threads");
+            std::vector<std::vector<SNvector<double,30>>> results(4);
+            std::vector<std::thread> threads;
+            for (unsigned int t=0;t<4;++t)
+            {
+                threads.emplace_back([&plu,&rhs,&results,t]
+                    {
+                        for (const auto& b:rhs)
+                        {
+                            results[t].push_back(plu.solve(b));
+                        }
+                    });
+            }
+            for (auto& thread:threads)
+            {
+                thread.join();
+            }
+            for (unsigned int t=0;t<4;++t)
+            {
+                for (unsigned int k=0;k<rhs.size();++k)
+                {
+                    for (unsigned int i=0;i<30;++i)
+                    {
+                        CPPUNIT_ASSERT(results[t][k].get(i)==solutions[k].get(i));
+                    }
+                }
+            }
+        }
+        void refactor_tests()
+        {
+            echo_function_test("refactor_tests");
+            double epsilon(0.0000001);
+            auto A=pseudoRandomMatrix<20>();
+            const auto plu=A.getPLU();
+
+            echo_single_test("small change : same permutation");
+            auto B=A;
+            for (m_num i=0;i<20;++i)
+            {
+                B.at(i,i)+=0.01;
+                B.at(i,(i+3)%20)-=0.02;
+            }
+            auto rplu=plu.refactor(B);
+            CPPUNIT_ASSERT(rplu.getMpermutation()==plu.getMpermutation());
+            auto prod=rplu.getP()*rplu.getL()*rplu.getU();
+            CPPUNIT_ASSERT(prod.isNumericallyEqual(B,epsilon));
+            auto b=someVector<20>(4);
+            CPPUNIT_ASSERT(isSolution(B,rplu.solve(b),b,epsilon));
+
+            echo_single_test("the same matrix : the same decomposition");
+            auto same=plu.refactor(A,1);
+            CPPUNIT_ASSERT(same.getU().isNumericallyEqual(plu.getU(),epsilon));
+            CPPUNIT_ASSERT(same.getL().isNumericallyEqual(plu.getL(),epsilon));
+
+            echo_single_test("bad pivot : back to getPLU");
+            auto C=pseudoRandomMatrix<20>(5);
+            auto cplu=plu.refactor(C,0.5);
+            CPPUNIT_ASSERT(cplu.getMpermutation()==C.getPLU().getMpermutation());
+            CPPUNIT_ASSERT(cplu.getU()==C.getPLU().getU());
+
+            echo_single_test("zero pivot : back to getPLU");
+            auto H=testMatrixH();
+            H.at(0,0)=0;
+            auto hplu=SNmatrix<double,4>(1).getPLU().refactor(H,0);
+            auto hprod=hplu.getP()*hplu.getL()*hplu.getU();
+            CPPUNIT_ASSERT(hprod.isNumericallyEqual(H,epsilon));
+            CPPUNIT_ASSERT(hplu.getMpermutation()==H.getPLU().getMpermutation());
+        }
+        void diagnostics_tests()
+        {
+            echo_function_test("diagnostics_tests");
+            double epsilon(0.0000001);
+
+            echo_single_test("solveTransposed");
+            auto A=pseudoRandomMatrix<20>();
+            auto plu=A.getPLU();
+            auto b=someVector<20>(8);
+            auto x=plu.solveTransposed(b);
+            SNmatrix<double,20> At;
+            for (m_num i=0;i<20;++i)
+            {
+                for (m_num j=0;j<20;++j)
+                {
+                    At.at(i,j)=A.get(j,i);
+                }
+            }
+            CPPUNIT_ASSERT(isSolution(At,x,b,epsilon));
+
+            echo_single_test("condition number");
+            auto H=testMatrixH();
+            auto hplu=H.getPLU();
+            double exact=exactInverseNorm1(hplu);
+            double estimate=hplu.estimateInverseNorm1();
+            CPPUNIT_ASSERT(estimate<=exact*(1+epsilon));
+            CPPUNIT_ASSERT(estimate>=exact/3);
+            exact=exactInverseNorm1(plu);
+            estimate=plu.estimateInverseNorm1();
+            CPPUNIT_ASSERT(estimate<=exact*(1+epsilon));
+            CPPUNIT_ASSERT(estimate>=exact/3);
+            SNmatrix<double,5> D(2);
+            CPPUNIT_ASSERT(D.getPLU().estimateCondition1(D)==1);
+
+            echo_single_test("pivot growth");
+            // The growth of Wilkinson's matrix is 2^(n-1).
+            SNmatrix<double,10> W(1);
+            for (m_num i=0;i<10;++i)
+            {
+                W.at(i,9)=1;
+                for (m_num j=0;j<i;++j)
+                {
+                    W.at(i,j)=-1;
+                }
+            }
+            CPPUNIT_ASSERT(W.getPLU().getPivotGrowth(W)==512);
+            CPPUNIT_ASSERT(plu.getPivotGrowth(A)>=1);
+
+            echo_single_test("zero pivots");
+            CPPUNIT_ASSERT(plu.getZeroPivotCount()==0);
+            auto Z=testMatrixH();
+            for (m_num i=0;i<4;++i)
+            {
+                Z.at(i,3)=0;
+            }
+            auto zplu=Z.getPLU();
+            CPPUNIT_ASSERT(zplu.getZeroPivotCount()==1);
+            CPPUNIT_ASSERT(std::isinf(zplu.estimateCondition1(Z)));
+        }
+        void determinant_tests()
+        {
+            echo_function_test("determinant_tests");
+            double epsilon(0.0000001);
+
+            // the determinant of a 2x2 matrix, with a swap.
+            SNmatrix<double,2> A;
+            A.at(0,0)=1; A.at(0,1)=2;
+            A.at(1,0)=3; A.at(1,1)=4;
+            auto plu=A.getPLU();
+            CPPUNIT_ASSERT(std::abs(plu.determinant()+2)<epsilon);
+            int sign=0;
+            CPPUNIT_ASSERT(std::abs(plu.logAbsDeterminant(sign)-std::log(2))<epsilon);
+            CPPUNIT_ASSERT(sign==-1);
+
+            echo_single_test("swapping two lines changes the sign");
+            auto H=testMatrixH();
+            auto G=H;
+            G.swapLines(0,2);
+            double det_H=H.getPLU().determinant();
+            CPPUNIT_ASSERT(std::abs(G.getPLU().determinant()+det_H)<epsilon);
+
+            echo_single_test("no overflow");
+            SNmatrix<double,100> B(1e10);
+            B.at(0,1)=1;
+            CPPUNIT_ASSERT(std::isinf(B.getPLU().determinant()));
+            CPPUNIT_ASSERT(std::abs(B.getPLU().logAbsDeterminant(sign)-100*std::log(1e10))<epsilon);
+            CPPUNIT_ASSERT(sign==1);
+            B.swapLines(0,1);
+            CPPUNIT_ASSERT(std::abs(B.getPLU().logAbsDeterminant(sign)-100*std::log(1e10))<epsilon);
+            CPPUNIT_ASSERT(sign==-1);
+
+            echo_single_test("the sign survives an underflow");
+            SNmatrix<double,3> D;
+            D.at(0,0)=-1e-200; D.at(1,1)=1e-200; D.at(2,2)=1e-200;
+            CPPUNIT_ASSERT(D.getPLU().determinant()==0);
+            CPPUNIT_ASSERT(std::abs(D.getPLU().logAbsDeterminant(sign)+600*std::log(10))<epsilon);
+            CPPUNIT_ASSERT(sign==-1);
+
+            echo_single_test("not invertible");
+            SNmatrix<double,3> Z;
+            CPPUNIT_ASSERT(Z.getPLU().determinant()==0);
+            CPPUNIT_ASSERT(std::isinf(Z.getPLU().logAbsDeterminant(sign)));
+            CPPUNIT_ASSERT(sign==0);
+        }
+        void inverse_tests()
+        {
+            echo_function_test("inverse_tests");
+            double epsilon(0.0000001);
+
+            auto H=testMatrixH();
+            auto invH=H.getPLU().inverse();
+            SNmatrix<double,4> ID(1);
+            CPPUNIT_ASSERT((H*invH).isNumericallyEqual(ID,epsilon));
+            CPPUNIT_ASSERT((invH*H).isNumericallyEqual(ID,epsilon));
+
+            echo_single_test("more than one block");
+            auto A=pseudoRandomMatrix<40>();
+            auto invA=A.getPLU().inverse();
+            CPPUNIT_ASSERT((A*invA).isNumericallyEqual(SNmatrix<double,40>(1),epsilon));
+
+            echo_single_test("a permutation matrix");
+            SNmatrix<double,3> Q;
+            Q.at(0,2)=1; Q.at(1,0)=1; Q.at(2,1)=1;
+            SNmatrix<double,3> Qt;
+            Qt.at(2,0)=1; Qt.at(0,1)=1; Qt.at(1,2)=1;
+            CPPUNIT_ASSERT(Q.getPLU().inverse()==Qt);
+        }
+        void sharing_tests()
+        {
+            echo_function_test("sharing_tests");
+            auto A=pseudoRandomMatrix<40>();
+            auto plu=A.getPLU();
+
+            echo_single_test("the copies share the factors");
+            auto copy=plu;
+            CPPUNIT_ASSERT(&copy.getL()==&plu.getL());
+            CPPUNIT_ASSERT(&copy.getU()==&plu.getU());
+
+            echo_single_test("assignment and move");
+            const SNupperTriangular<double,40>* U=&plu.getU();
+            auto moved=std::move(copy);
+            CPPUNIT_ASSERT(&moved.getU()==U);
+            auto plu2=pseudoRandomMatrix<40>(3).getPLU();
+            plu2=moved;
+            CPPUNIT_ASSERT(&plu2.getU()==U);
+            CPPUNIT_ASSERT(plu2.getMemoryUsage()>=sizeof(SNupperTriangular<double,40>));
+        }
     public:
         void runTest()
         {
             launch_auto_tests_sage();
             plu_from_PLU_tests();
+            solve_tests();
+            concurrent_solve_tests();
+            refactor_tests();
+            diagnostics_tests();
+            determinant_tests();
+            inverse_tests();
+            sharing_tests();
         }
 };
 
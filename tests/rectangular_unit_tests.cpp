@@ -0,0 +1,172 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNmatrices/SNrectangular.h"
+#include "TestMatrices.cpp"
+
+template <unsigned int l,unsigned int c>
+SNrectangular<double,l,c> pseudoRandomRectangular(unsigned int seed)
+{
+    SNrectangular<double,l,c> R;
+    for (m_num j=0;j<c;++j)
+    {
+        for (m_num i=0;i<l;++i)
+        {
+            seed=(1103515245*seed+12345)%2147483648u;
+            R(i,j)=double(seed%1000)/100-5;
+        }
+    }
+    return R;
+}
+
+class RectangularTest : public CppUnit::TestCase
+{
+    private :
+        void storage_tests()
+        {
+            echo_function_test("storage_tests");
+            constexpr SNrectangular<int,2,3> R(std::array<int,6>{{1,2,3,4,5,6}});
+            static_assert(R(1,0)==2 and R(0,2)==5,"column major");
+            static_assert(R.getLines()==2 and R.getColumns()==3,"dimensions");
+
+            // a 64x4 panel instead of a padded 64x64 matrix
+            CPPUNIT_ASSERT((sizeof(SNrectangular<double,64,4>)==64*4*sizeof(double)));
+
+            SNrectangular<double,4,2> Z;
+            CPPUNIT_ASSERT(Z.get(3,1)==0);
+            bool thrown=false;
+            try
+            {
+                Z.at(1,2)=1;
+            }
+            catch (const RectangularOutOfRangeException& e)
+            {
+                thrown=std::string(e.what())=="Attempt to access element (1 , 2 ) while the matrix is 4x2";
+            }
+            CPPUNIT_ASSERT(thrown);
+        }
+        void transpose_tests()
+        {
+            echo_function_test("transpose_tests");
+            auto R=pseudoRandomRectangular<5,3>(7);
+            const SNrectangular<double,3,5> T=R.transpose();
+            for (m_num i=0;i<5;++i)
+            {
+                for (m_num j=0;j<3;++j)
+                {
+                    CPPUNIT_ASSERT(T(j,i)==R(i,j));
+                }
+            }
+            CPPUNIT_ASSERT(T.transpose()==R);
+        }
+        void product_tests()
+        {
+            echo_function_test("product_tests");
+            auto A=pseudoRandomRectangular<5,3>(7);
+            auto B=pseudoRandomRectangular<3,4>(13);
+            const SNrectangular<double,5,4> C=A*B;
+            for (m_num i=0;i<5;++i)
+            {
+                for (m_num j=0;j<4;++j)
+                {
+                    double s=0;
+                    for (m_num k=0;k<3;++k)
+                    {
+                        s+=A(i,k)*B(k,j);
+                    }
+                    CPPUNIT_ASSERT(std::abs(C(i,j)-s)<1e-12);
+                }
+            }
+        }
+        void square_product_tests()
+        {
+            echo_function_test("square_product_tests");
+            auto M=pseudoRandomMatrix<5>(3);
+            auto V=pseudoRandomRectangular<5,2>(19);
+            auto W=V.transpose();
+
+            // restriction of M on the space spanned by the columns of V
+            const SNrectangular<double,2,2> H=W*M*V;
+            const SNrectangular<double,5,5> Ms(M);
+            CPPUNIT_ASSERT(M*V==Ms*V);
+            CPPUNIT_ASSERT(W*M==W*Ms);
+            const auto H2=W*(Ms*V);
+            for (m_num i=0;i<2;++i)
+            {
+                for (m_num j=0;j<2;++j)
+                {
+                    CPPUNIT_ASSERT(std::abs(H(i,j)-H2(i,j))<1e-10);
+                }
+            }
+
+            echo_single_test("the layouts and the other square types");
+            const SNmatrix<double,5,RowMajor> R(M);
+            const SNmatrix<double,5,TiledZOrder<2>> Z(M);
+            CPPUNIT_ASSERT(R*V==M*V);
+            CPPUNIT_ASSERT(Z*V==M*V);
+            CPPUNIT_ASSERT(W*R==W*M);
+            const SNgeneric<double,5>& G=M;
+            CPPUNIT_ASSERT(G*V==M*V);
+            CPPUNIT_ASSERT(W*G==W*M);
+            SNupperTriangular<double,5> U;
+            for (m_num i=0;i<5;++i)
+            {
+                for (m_num j=i;j<5;++j)
+                {
+                    U.at(i,j)=M.get(i,j);
+                }
+            }
+            const SNrectangular<double,5,5> Us(U);
+            CPPUNIT_ASSERT(U*V==Us*V);
+        }
+        void vector_tests()
+        {
+            echo_function_test("vector_tests");
+            auto A=pseudoRandomRectangular<4,3>(23);
+            SNvector<double,3> x;
+            x.at(0)=1;
+            x.at(1)=-2;
+            x.at(2)=0.5;
+            const SNvector<double,4> y=A*x;
+            for (m_num i=0;i<4;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(y.get(i)-(A(i,0)-2*A(i,1)+0.5*A(i,2)))<1e-12);
+            }
+        }
+    public:
+        void runTest()
+        {
+            storage_tests();
+            transpose_tests();
+            product_tests();
+            square_product_tests();
+            vector_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"RectangularTest"<<std::endl;
+    RectangularTest rectangular_test;
+    rectangular_test.runTest();
+}
@@ -123,6 +123,17 @@ class SNlineTest : public CppUnit::TestCase
         CPPUNIT_ASSERT(l1.get(2)==6);
         CPPUNIT_ASSERT(l2.get(0)==1);
         CPPUNIT_ASSERT(l2.get(2)==6.1);
+
+        // from a view, whatever the layout
+        SNmatrix<double,3,RowMajor> R(A);
+        CPPUNIT_ASSERT((SNline<double,3>(R.getLineView(2))==l2));
+        CPPUNIT_ASSERT((SNline<double,3>(A.getLineView(1))==l1));
+
+        // the product by a scalar
+        auto m=2.*l0;
+        CPPUNIT_ASSERT(m.get(0)==2);
+        CPPUNIT_ASSERT(m.get(1)==-6);
+        CPPUNIT_ASSERT(m.get(2)==10);
     }
 
     public :
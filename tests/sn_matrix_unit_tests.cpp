@@ -21,6 +21,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <cppunit/TestAssert.h>
 
 #include "../src/SNmatrices/SNmatrix.h"
+#include "../src/SNplu.h"
+
+#include <cstdint>
+#include <vector>
 
 #include "TestMatrices.cpp"
 
@@ -158,6 +162,95 @@ class SNmatrixTest : public CppUnit::TestCase
         CPPUNIT_ASSERT(U==4*id);
     }
 
+    /**
+     * Copy 'A' in a matrix with the layout 'Layout', check the elements,
+     * swap two lines and compare the PLU decompositions with the ones
+     * of the column major matrix.
+     * */
+    template <class Layout,unsigned int s>
+    void check_layout(const SNmatrix<double,s>& A)
+    {
+        SNmatrix<double,s,Layout> B(A);
+        for (m_num i=0;i<s;++i)
+        {
+            for (m_num j=0;j<s;++j)
+            {
+                CPPUNIT_ASSERT(B.get(i,j)==A.get(i,j));
+            }
+        }
+        CPPUNIT_ASSERT(B.max_norm()==A.max_norm());
+
+        SNmatrix<double,s> Aswap(A);
+        Aswap.swapLines(1,s-1);
+        B.swapLines(1,s-1);
+        for (m_num j=0;j<s;++j)
+        {
+            CPPUNIT_ASSERT(B.get(1,j)==Aswap.get(1,j));
+            CPPUNIT_ASSERT(B.get(s-1,j)==Aswap.get(s-1,j));
+        }
+        B.swapLines(1,s-1);
+
+        auto plu_A=A.getPLU();
+        auto plu_B=B.getPLU();
+        CPPUNIT_ASSERT(plu_A.getL()==plu_B.getL());
+        CPPUNIT_ASSERT(plu_A.getU()==plu_B.getU());
+        CPPUNIT_ASSERT(plu_A.getMpermutation()==plu_B.getMpermutation());
+    }
+    void test_layouts()
+    {
+        echo_function_test("test_layouts");
+        auto A=pseudoRandomMatrix<5>();
+        check_layout<ColumnMajor>(A);
+        check_layout<RowMajor>(A);
+        check_layout<TiledZOrder<2>>(A);
+
+        // 30 is not a multiple of the tile size : there is some padding.
+        auto C=pseudoRandomMatrix<30>();
+        check_layout<RowMajor>(C);
+        check_layout<TiledZOrder<8>>(C);
+        check_layout<PaddedColumnMajor<8>>(C);
+        check_layout<PaddedColumnMajor<8>>(A);
+        typedef TiledZOrder<8> Tiled;
+        CPPUNIT_ASSERT(Tiled::storageSize(30)==32*32);
+        CPPUNIT_ASSERT(Tiled::storageSize(40)==64*64);
+
+        SNmatrix<double,3,RowMajor> R(2);
+        CPPUNIT_ASSERT(R.get(1,1)==2);
+        CPPUNIT_ASSERT(R.get(0,1)==0);
+    }
+
+    bool isAligned(const void* p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p)%cache_line_bytes==0;
+    }
+    void test_alignment()
+    {
+        echo_function_test("test_alignment");
+        typedef PaddedColumnMajor<8> Padded;
+        CPPUNIT_ASSERT(Padded::leadingDimension(100)==104);
+        CPPUNIT_ASSERT(Padded::leadingDimension(3)==8);
+        // power of two : one more cache line
+        CPPUNIT_ASSERT(Padded::leadingDimension(128)==136);
+        CPPUNIT_ASSERT(Padded::storageSize(30)==32*30);
+
+        SNmatrix<double,30,Padded> P(pseudoRandomMatrix<30>());
+        for (m_num j=0;j<30;++j)
+        {
+            CPPUNIT_ASSERT(isAligned(&P.data[Padded::index(0,j,30)]));
+        }
+
+        SNmatrix<double,100> A;
+        CPPUNIT_ASSERT(isAligned(A.data.data()));
+        CPPUNIT_ASSERT(alignof(SNvector<double,100>)==cache_line_bytes);
+        CPPUNIT_ASSERT(alignof(SNvector<double,3>)==alignof(double));
+
+        std::vector<SNvector<double,16>> vectors(5);
+        for (auto& v:vectors)
+        {
+            CPPUNIT_ASSERT(isAligned(v.data()));
+        }
+    }
+
     public :
         void runTest()
         {
@@ -169,6 +262,8 @@ class SNmatrixTest : public CppUnit::TestCase
             test_copy_constructor();
             test_swap_line();
             test_max_norm();
+            test_layouts();
+            test_alignment();
         }
 };
 
@@ -23,6 +23,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <cppunit/TestAssert.h>
 
 #include "../src/SNmatrices/SNline.h"
+#include "../src/SNmatrices/MpivotSequence.h"
+#include "../src/SNmatrices/MlazyPermutation.h"
 #include "../src/SNplu.h"
 #include "../src/SNmatrices/SNmatrix.h"
 #include "TestMatrices.cpp"
@@ -52,6 +54,7 @@ class SNpermutationsTest : public CppUnit::TestCase
 
             echo_single_test("Test throwing when asking a too large number (>tp_size)");
             CPPUNIT_ASSERT_THROW(std::cout<<permID(12),PermutationIdexoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(permID.image(4),PermutationIdexoutOfRangeException);
 
             echo_single_test("Test an arbitrary permutation");
             std::array<unsigned int, 4> a3{ {1,2, 0, 3} };
@@ -182,6 +185,163 @@ class SNpermutationsTest : public CppUnit::TestCase
         echo_single_test("inverse matrix of a permutation");
         CPPUNIT_ASSERT(ans_iP1==iP1);
 
+        }
+        void test_signature()
+        {
+            echo_function_test("test_signature");
+            std::array<unsigned int, 4> a3{ {1,2, 0, 3} };   // a 3-cycle
+            std::array<unsigned int, 4> a5{ {3,2, 1, 0} };   // two transpositions
+            std::array<unsigned int, 4> a6{ {2,1,3,0} };     // a 3-cycle
+            std::array<unsigned int, 4> a7{ {1,2,3,0} };     // a 4-cycle
+            CPPUNIT_ASSERT(Mpermutation<4>().signature()==1);
+            CPPUNIT_ASSERT(Mpermutation<4>(a3).signature()==1);
+            CPPUNIT_ASSERT(Mpermutation<4>(a5).signature()==1);
+            CPPUNIT_ASSERT(Mpermutation<4>(a6).signature()==1);
+            CPPUNIT_ASSERT(Mpermutation<4>(a7).signature()==-1);
+            CPPUNIT_ASSERT(Mpermutation<4>(MelementaryPermutation<4>(1,3)).signature()==-1);
+        }
+        void test_vector_action()
+        {
+            echo_function_test("test_vector_action");
+            std::array<unsigned int, 6> a{ {2,0,1,5,4,3} };
+            Mpermutation<6> perm(a);
+            SNpermutation<double,6> mat(perm);
+            SNvector<double,6> v;
+            for (unsigned int i=0;i<6;++i)
+            {
+                v.at(i)=10+i;
+            }
+
+            echo_single_test("scatter is Pv");
+            auto pv=perm.scatter(v);
+            for (m_num i=0;i<6;++i)
+            {
+                double acc=0;
+                for (m_num j=0;j<6;++j)
+                {
+                    acc+=mat.get(i,j)*v.get(j);
+                }
+                CPPUNIT_ASSERT(pv.get(i)==acc);
+            }
+
+            echo_single_test("gather is the inverse of scatter");
+            auto back=perm.gather(pv);
+            for (unsigned int i=0;i<6;++i)
+            {
+                CPPUNIT_ASSERT(back.get(i)==v.get(i));
+            }
+
+            echo_single_test("in place");
+            auto w=v;
+            perm.applyInPlace(w);
+            for (unsigned int i=0;i<6;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==pv.get(i));
+            }
+            perm.applyInverseInPlace(w);
+            for (unsigned int i=0;i<6;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==v.get(i));
+            }
+            auto u=v;
+            perm.inverse().applyInPlace(u);
+            auto x=perm.gather(v);
+            for (unsigned int i=0;i<6;++i)
+            {
+                CPPUNIT_ASSERT(u.get(i)==x.get(i));
+            }
+        }
+        void test_pivot_sequence()
+        {
+            echo_function_test("test_pivot_sequence");
+            std::array<unsigned int, 5> pivots{ {3,1,4,4,4} };
+            MpivotSequence<5> seq(pivots);
+
+            // the product tau_0 tau_1 ... of the transpositions
+            Mpermutation<5> prod;
+            for (unsigned int c=0;c<5;++c)
+            {
+                prod=prod*MelementaryPermutation<5>(c,pivots[c]);
+            }
+            CPPUNIT_ASSERT(seq.toMpermutation()==prod);
+            for (unsigned int k=0;k<5;++k)
+            {
+                CPPUNIT_ASSERT(seq.image(k)==prod.image(k));
+            }
+
+            SNvector<double,5> v;
+            for (unsigned int i=0;i<5;++i)
+            {
+                v.at(i)=i*i+1;
+            }
+            auto w=v;
+            seq.applyInPlace(w);
+            auto pv=prod.scatter(v);
+            for (unsigned int i=0;i<5;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==pv.get(i));
+            }
+            seq.applyInverseInPlace(w);
+            for (unsigned int i=0;i<5;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==v.get(i));
+            }
+
+            CPPUNIT_ASSERT(MpivotSequence<5>().toMpermutation()==Mpermutation<5>());
+            CPPUNIT_ASSERT_THROW(seq.setPivot(1,5),PermutationIdexoutOfRangeException);
+        }
+        void test_lazy_permutation()
+        {
+            echo_function_test("test_lazy_permutation");
+            MlazyPermutation<5> lazy;
+            Mpermutation<5> dense;
+            const unsigned int swaps[][2]={ {0,3},{1,1},{2,4},{4,0},{3,1} };
+            for (const auto& s:swaps)
+            {
+                lazy=lazy*MelementaryPermutation<5>(s[0],s[1]);
+                dense=dense*MelementaryPermutation<5>(s[0],s[1]);
+            }
+            CPPUNIT_ASSERT(lazy.getTranspositionCount()==4);    // (1,1) is dropped
+            CPPUNIT_ASSERT(lazy.toMpermutation()==dense);
+            for (unsigned int k=0;k<5;++k)
+            {
+                CPPUNIT_ASSERT(lazy.image(k)==dense.image(k));
+            }
+
+            echo_single_test("fusion");
+            lazy*=MelementaryPermutation<5>(1,3);     // cancels (3,1)
+            dense=dense*MelementaryPermutation<5>(1,3);
+            CPPUNIT_ASSERT(lazy.getTranspositionCount()==3);
+            CPPUNIT_ASSERT(lazy.toMpermutation()==dense);
+            lazy*=MelementaryPermutation<5>(2,3);
+            dense=dense*MelementaryPermutation<5>(2,3);
+            CPPUNIT_ASSERT(lazy.toMpermutation()==dense);
+
+            echo_single_test("product of lazy permutations");
+            auto square=lazy*lazy;
+            CPPUNIT_ASSERT(square.toMpermutation()==dense*dense);
+            lazy*=lazy;
+            CPPUNIT_ASSERT(lazy.toMpermutation()==dense*dense);
+
+            echo_single_test("action on the vectors");
+            SNvector<double,5> v;
+            for (unsigned int i=0;i<5;++i)
+            {
+                v.at(i)=3*i+1;
+            }
+            auto w=v;
+            lazy.applyInPlace(w);
+            auto pv=lazy.toMpermutation().scatter(v);
+            for (unsigned int i=0;i<5;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==pv.get(i));
+            }
+            lazy.applyInverseInPlace(w);
+            for (unsigned int i=0;i<5;++i)
+            {
+                CPPUNIT_ASSERT(w.get(i)==v.get(i));
+            }
+            CPPUNIT_ASSERT_THROW(lazy.multiply(0,5),OutOfRangeConstructionElementaryPermutationException);
         }
         void test_identity_initialization()
         {
@@ -199,6 +359,10 @@ class SNpermutationsTest : public CppUnit::TestCase
             test_identity_initialization();
             test_product();
             test_identity();
+            test_signature();
+            test_vector_action();
+            test_pivot_sequence();
+            test_lazy_permutation();
         }
 };
 
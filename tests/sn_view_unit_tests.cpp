@@ -0,0 +1,117 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNmatrices/SNmatrix.h"
+#include "../src/SNplu.h"
+#include "TestMatrices.cpp"
+
+class SNviewTest : public CppUnit::TestCase
+{
+    private :
+        template <class Layout>
+        void check_views()
+        {
+            SNmatrix<double,5,Layout> A(pseudoRandomMatrix<5>());
+            const SNmatrix<double,5,Layout> B(A);
+
+            echo_single_test("reading through the views");
+            auto line=B.getLineView(2);
+            auto col=B.getColumnView(3);
+            for (m_num k=0;k<5;++k)
+            {
+                CPPUNIT_ASSERT(line.get(k)==B.get(2,k));
+                CPPUNIT_ASSERT(col.get(k)==B.get(k,3));
+            }
+
+            echo_single_test("writing through the views");
+            A.getLineView(1).at(4)=7;
+            CPPUNIT_ASSERT(A.get(1,4)==7);
+            A.getColumnView(0)[3]=-2;
+            CPPUNIT_ASSERT(A.get(3,0)==-2);
+
+            echo_single_test("scaled subtraction, from the column 2");
+            A=B;
+            A.getLineView(0).subtractScaled(3,A.getLineView(4),2);
+            for (m_num k=0;k<5;++k)
+            {
+                double expected= k<2 ? B.get(0,k) : B.get(0,k)-3*B.get(4,k);
+                CPPUNIT_ASSERT(A.get(0,k)==expected);
+            }
+            A=B;
+            A.getColumnView(1).subtractScaled(0.5,B.getColumnView(2));
+            A.getColumnView(3).scale(2,1);
+            for (m_num k=0;k<5;++k)
+            {
+                CPPUNIT_ASSERT(A.get(k,1)==B.get(k,1)-0.5*B.get(k,2));
+                CPPUNIT_ASSERT(A.get(k,3)==(k<1 ? B.get(k,3) : 2*B.get(k,3)));
+            }
+
+            echo_single_test("swap");
+            A=B;
+            A.getColumnView(0).swap(A.getColumnView(4));
+            A.getLineView(3).swap(A.getLineView(3));
+            for (m_num k=0;k<5;++k)
+            {
+                CPPUNIT_ASSERT(A.get(k,0)==B.get(k,4));
+                CPPUNIT_ASSERT(A.get(k,4)==B.get(k,0));
+            }
+        }
+        void test_views()
+        {
+            echo_function_test("test_views");
+            check_views<ColumnMajor>();
+            check_views<RowMajor>();
+            check_views<TiledZOrder<2>>();
+        }
+        void test_out_of_range()
+        {
+            echo_function_test("test_out_of_range");
+            SNmatrix<double,3> A(1);
+            CPPUNIT_ASSERT_THROW(A.getLineView(3),SNoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(A.getColumnView(3),SNoutOfRangeException);
+            CPPUNIT_ASSERT_THROW(A.getLineView(0).at(3),SNoutOfRangeException);
+        }
+        void test_elimination()
+        {
+            echo_function_test("test_elimination");
+            // the elimination through the views gives a correct PLU.
+            auto A=pseudoRandomMatrix<20>();
+            auto plu=A.getPLU();
+            SNmatrix<double,20> P(plu.getP());
+            SNmatrix<double,20> PLU=P*(plu.getL()*plu.getU());
+            CPPUNIT_ASSERT(PLU.isNumericallyEqual(A,0.0000001));
+        }
+    public:
+        void runTest()
+        {
+            test_views();
+            test_out_of_range();
+            test_elimination();
+        }
+};
+
+int main ()
+{
+    std::cout<<"SNviewTest"<<std::endl;
+    SNviewTest sn_view_test;
+    sn_view_test.runTest();
+}
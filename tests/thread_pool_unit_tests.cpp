@@ -0,0 +1,137 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/ThreadPool.h"
+#include "../src/SNplu.h"
+#include "TestMatrices.cpp"
+
+class ThreadPoolTest : public CppUnit::TestCase
+{
+    private :
+        void parallel_for_tests()
+        {
+            echo_function_test("parallel_for_tests");
+            ThreadPool pool(4);
+            CPPUNIT_ASSERT(pool.getThreadCount()==4);
+
+            echo_single_test("each index is visited once");
+            std::vector<int> visits(1000,0);
+            pool.parallelFor(0,1000,[&visits](unsigned int first,unsigned int last)
+                {
+                    for (unsigned int k=first;k<last;++k)
+                    {
+                        ++visits.at(k);
+                    }
+                });
+            for (int v:visits)
+            {
+                CPPUNIT_ASSERT(v==1);
+            }
+
+            echo_single_test("less indices than threads");
+            std::atomic<int> count(0);
+            pool.parallelFor(5,7,[&count](unsigned int first,unsigned int last)
+                {
+                    count+=last-first;
+                });
+            CPPUNIT_ASSERT(count==2);
+            pool.parallelFor(3,3,[&count](unsigned int,unsigned int)
+                {
+                    ++count;
+                });
+            CPPUNIT_ASSERT(count==2);
+        }
+        void exception_tests()
+        {
+            echo_function_test("exception_tests");
+            ThreadPool pool(3);
+            CPPUNIT_ASSERT_THROW(pool.parallelFor(0,100,[](unsigned int first,unsigned int)
+                {
+                    if (first>0)
+                    {
+                        throw std::runtime_error("from a chunk");
+                    }
+                }),std::runtime_error);
+
+            echo_single_test("the pool is still usable");
+            std::atomic<int> count(0);
+            pool.parallelFor(0,100,[&count](unsigned int first,unsigned int last)
+                {
+                    count+=last-first;
+                });
+            CPPUNIT_ASSERT(count==100);
+        }
+        void nested_tests()
+        {
+            echo_function_test("nested_tests");
+            ThreadPool pool(2);
+            std::atomic<int> count(0);
+            pool.parallelFor(0,10,[&](unsigned int first,unsigned int last)
+                {
+                    for (unsigned int k=first;k<last;++k)
+                    {
+                        pool.parallelFor(0,10,[&count](unsigned int f,unsigned int l)
+                            {
+                                count+=l-f;
+                            });
+                    }
+                });
+            CPPUNIT_ASSERT(count==100);
+        }
+        void parallel_plu_tests()
+        {
+            echo_function_test("parallel_plu_tests");
+            ThreadPool pool(4);
+
+            echo_single_test("large matrix : same result as the serial one");
+            auto A=pseudoRandomMatrix<40>();
+            auto plu=A.getPLU();
+            auto pplu=A.getPLU(pool,8);
+            CPPUNIT_ASSERT(pplu.getMpermutation()==plu.getMpermutation());
+            CPPUNIT_ASSERT(pplu.getL()==plu.getL());
+            CPPUNIT_ASSERT(pplu.getU()==plu.getU());
+
+            echo_single_test("small matrix : serial");
+            auto B=testMatrixL();
+            auto bplu=B.getPLU(pool);
+            CPPUNIT_ASSERT(bplu.getU()==B.getPLU().getU());
+        }
+    public:
+        void runTest()
+        {
+            parallel_for_tests();
+            exception_tests();
+            nested_tests();
+            parallel_plu_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"ThreadPoolTest"<<std::endl;
+    ThreadPoolTest thread_pool_test;
+    thread_pool_test.runTest();
+}
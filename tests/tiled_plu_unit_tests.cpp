@@ -0,0 +1,159 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/TaskGraph.h"
+#include "../src/SNtiledPLU.h"
+#include "TestMatrices.cpp"
+
+class TiledPLUTest : public CppUnit::TestCase
+{
+    private :
+        void task_graph_tests()
+        {
+            echo_function_test("task_graph_tests");
+            ThreadPool pool(3);
+
+            // A chain of 'diamonds' : a -> b,c -> d -> ...
+            TaskGraph graph;
+            std::mutex mutex;
+            std::vector<unsigned int> order;
+            auto record=[&](unsigned int t)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(t);
+            };
+            std::vector<std::pair<unsigned int,unsigned int>> edges;
+            unsigned int previous=graph.addTask([&]{ record(0); });
+            for (unsigned int k=0;k<20;++k)
+            {
+                unsigned int b=graph.addTask([&,k]{ record(3*k+1); });
+                unsigned int c=graph.addTask([&,k]{ record(3*k+2); },true);
+                unsigned int d=graph.addTask([&,k]{ record(3*k+3); });
+                edges.push_back({previous,b});
+                edges.push_back({previous,c});
+                edges.push_back({b,d});
+                edges.push_back({c,d});
+                previous=d;
+            }
+            for (auto e:edges)
+            {
+                graph.addDependency(e.first,e.second);
+            }
+            CPPUNIT_ASSERT(graph.getTaskCount()==61);
+            graph.run(pool);
+
+            echo_single_test("each task once, dependencies respected");
+            CPPUNIT_ASSERT(order.size()==61);
+            std::vector<unsigned int> position(61);
+            for (unsigned int p=0;p<order.size();++p)
+            {
+                position.at(order[p])=p;
+            }
+            for (auto e:edges)
+            {
+                CPPUNIT_ASSERT(position[e.first]<position[e.second]);
+            }
+
+            echo_single_test("an exception stops the graph");
+            TaskGraph failing;
+            unsigned int a=failing.addTask([]{ throw std::runtime_error("from a task"); });
+            unsigned int b=failing.addTask([&]{ record(1000); });
+            failing.addDependency(a,b);
+            CPPUNIT_ASSERT_THROW(failing.run(pool),std::runtime_error);
+            CPPUNIT_ASSERT(order.size()==61);
+
+            echo_single_test("the idle workers sleep");
+            // A chain : only one task is ready at a time. The tasks do not
+            // use the CPU, so the process does not either (unless the three
+            // other workers spin while waiting).
+            TaskGraph chain;
+            unsigned int last=chain.addTask([]{ std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+            for (unsigned int k=0;k<10;++k)
+            {
+                unsigned int next=chain.addTask([]{ std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+                chain.addDependency(last,next);
+                last=next;
+            }
+            const std::clock_t cpu_start=std::clock();
+            const auto wall_start=std::chrono::steady_clock::now();
+            chain.run(pool);
+            const double cpu=double(std::clock()-cpu_start)/CLOCKS_PER_SEC;
+            const double wall=std::chrono::duration<double>(std::chrono::steady_clock::now()-wall_start).count();
+            CPPUNIT_ASSERT(wall>=0.2);
+            CPPUNIT_ASSERT(cpu<0.5*wall);
+        }
+        template <unsigned int s>
+        void compare_with_getPLU(const SNmatrix<double,s>& A,ThreadPool& pool,unsigned int tile_size)
+        {
+            echo_single_test("tile size "+std::to_string(tile_size));
+            double epsilon(0.0000001);
+            auto plu=A.getPLU();
+            SNtiledPLU<double,s> tiled(A,pool,tile_size);
+            auto tplu=tiled.getPLU();
+            CPPUNIT_ASSERT(tplu.getMpermutation()==plu.getMpermutation());
+            CPPUNIT_ASSERT(tplu.getL().isNumericallyEqual(plu.getL(),epsilon));
+            CPPUNIT_ASSERT(tplu.getU().isNumericallyEqual(plu.getU(),epsilon));
+        }
+        void tiled_plu_tests()
+        {
+            echo_function_test("tiled_plu_tests");
+            ThreadPool pool(4);
+            auto A=pseudoRandomMatrix<40>();
+            compare_with_getPLU(A,pool,1);
+            compare_with_getPLU(A,pool,7);
+            compare_with_getPLU(A,pool,8);
+            compare_with_getPLU(A,pool,40);
+            compare_with_getPLU(A,pool,64);
+            compare_with_getPLU(testMatrixL(),pool,2);
+        }
+        void singular_tests()
+        {
+            echo_function_test("singular_tests");
+            ThreadPool pool(2);
+            double epsilon(0.0000001);
+            SNtiledPLU<double,3> tiled(testMatrixA(),pool,2);
+            auto plu=tiled.getPLU();
+            auto prod=plu.getP()*plu.getL()*plu.getU();
+            CPPUNIT_ASSERT(prod.isNumericallyEqual(testMatrixA(),epsilon));
+        }
+    public:
+        void runTest()
+        {
+            task_graph_tests();
+            tiled_plu_tests();
+            singular_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"TiledPLUTest"<<std::endl;
+    TiledPLUTest tiled_test;
+    tiled_test.runTest();
+}
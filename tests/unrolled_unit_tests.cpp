@@ -0,0 +1,178 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNindirectPLU.h"
+#include "TestMatrices.cpp"
+
+class UnrolledTest : public CppUnit::TestCase
+{
+    private :
+        // The unrolled kernels do the same operations in the same order
+        // as the generic loops : the results are exactly the same.
+        template <unsigned int s>
+        void compare_product()
+        {
+            auto A=pseudoRandomMatrix<s>(5);
+            auto B=pseudoRandomMatrix<s>(11);
+            const SNmatrix<double,s> C=A*B;
+            for (unsigned int i=0;i<s;++i)
+            {
+                for (unsigned int j=0;j<s;++j)
+                {
+                    CPPUNIT_ASSERT(C.get(i,j)==matrixProductComponent(A,B,i,j));
+                }
+            }
+        }
+        void product_tests()
+        {
+            echo_function_test("product_tests");
+            compare_product<2>();
+            compare_product<3>();
+            compare_product<4>();
+            compare_product<5>();
+            compare_product<6>();
+            compare_product<7>();
+            compare_product<8>();
+        }
+
+        // The two paths of 'getPLU' and of 'SNplu::solve' (the unrolled one
+        // is chosen for these sizes) give the same numbers.
+        template <unsigned int s>
+        void compare_with_generic(const SNmatrix<double,s>& A)
+        {
+            echo_single_test("size "+std::to_string(s));
+            const auto plu=A.getPLU(std::true_type());
+            const auto gplu=A.getPLU(std::false_type());
+            CPPUNIT_ASSERT(plu.getMpermutation()==gplu.getMpermutation());
+            CPPUNIT_ASSERT(plu.getZeroPivotCount()==gplu.getZeroPivotCount());
+            const auto L=plu.getL();
+            const auto gL=gplu.getL();
+            const auto U=plu.getU();
+            const auto gU=gplu.getU();
+            for (m_num i=0;i<s;++i)
+            {
+                for (m_num j=0;j<s;++j)
+                {
+                    CPPUNIT_ASSERT(L.get(i,j)==gL.get(i,j));
+                    CPPUNIT_ASSERT(U.get(i,j)==gU.get(i,j));
+                }
+            }
+
+            SNvector<double,s> b;
+            for (unsigned int i=0;i<s;++i)
+            {
+                b.at(i)=double(i%5)-2;
+            }
+            const auto x=plu.solve(b,std::true_type());
+            const auto y=plu.solve(b,std::false_type());
+            for (unsigned int i=0;i<s;++i)
+            {
+                CPPUNIT_ASSERT(x.get(i)==y.get(i));
+            }
+        }
+        void generic_path_tests()
+        {
+            echo_function_test("generic_path_tests");
+            compare_with_generic(pseudoRandomMatrix<2>(3));
+            compare_with_generic(pseudoRandomMatrix<3>(3));
+            compare_with_generic(pseudoRandomMatrix<4>(3));
+            compare_with_generic(pseudoRandomMatrix<5>(3));
+            compare_with_generic(pseudoRandomMatrix<6>(3));
+            compare_with_generic(pseudoRandomMatrix<7>(3));
+            compare_with_generic(pseudoRandomMatrix<8>(3));
+            compare_with_generic(testMatrixA());
+            compare_with_generic(testMatrixH());
+        }
+
+        template <unsigned int s>
+        void compare_plu(const SNmatrix<double,s>& A)
+        {
+            auto plu=A.getPLU();
+            auto iplu=A.getIndirectPLU().getPLU();
+            CPPUNIT_ASSERT(plu.getMpermutation()==iplu.getMpermutation());
+            CPPUNIT_ASSERT(plu.getL()==iplu.getL());
+            CPPUNIT_ASSERT(plu.getU()==iplu.getU());
+
+            SNvector<double,s> b;
+            for (unsigned int i=0;i<s;++i)
+            {
+                b.at(i)=double(i%5)-2;
+            }
+            auto x=plu.solve(b);
+            auto y=iplu.solve(b);
+            for (unsigned int i=0;i<s;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(x.get(i)-y.get(i))<0.0000001);
+            }
+        }
+        void plu_tests()
+        {
+            echo_function_test("plu_tests");
+            compare_plu(pseudoRandomMatrix<2>());
+            compare_plu(pseudoRandomMatrix<3>());
+            compare_plu(testMatrixE());
+            compare_plu(testMatrixH());
+            compare_plu(pseudoRandomMatrix<7>());
+            compare_plu(pseudoRandomMatrix<8>());
+        }
+        void zero_column_tests()
+        {
+            echo_function_test("zero_column_tests");
+            auto H=testMatrixH();
+            for (m_num i=0;i<4;++i)
+            {
+                H.at(i,3)=0;
+            }
+            auto plu=H.getPLU();
+            CPPUNIT_ASSERT(plu.getU()==H.getIndirectPLU().getPLU().getU());
+            CPPUNIT_ASSERT(plu.getZeroPivotCount()==1);
+        }
+        void unrolled_for_tests()
+        {
+            echo_function_test("unrolled_for_tests");
+            unsigned int sum=0;
+            unrolledFor<2,5>([&](auto k)
+                {
+                    static_assert(decltype(k)::value>=2,"constant index");
+                    sum=10*sum+k;
+                });
+            CPPUNIT_ASSERT(sum==234);
+            unrolledFor<3,3>([&](auto) { sum=0; });
+            CPPUNIT_ASSERT(sum==234);
+        }
+    public:
+        void runTest()
+        {
+            unrolled_for_tests();
+            product_tests();
+            generic_path_tests();
+            plu_tests();
+            zero_column_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"UnrolledTest"<<std::endl;
+    UnrolledTest unrolled_test;
+    unrolled_test.runTest();
+}
@@ -0,0 +1,154 @@
+/*
+Copyright 2017 Laurent Claessens
+contact : laurent@claessens-donadello.eu
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <cppunit/TestAssert.h>
+
+#include "../src/SNupdatedPLU.h"
+#include "TestMatrices.cpp"
+
+template <unsigned int s>
+SNvector<double,s> someVector(unsigned int k)
+{
+    SNvector<double,s> v;
+    for (unsigned int i=0;i<s;++i)
+    {
+        v.at(i)=double((i*7+k*3)%11)-5;
+    }
+    return v;
+}
+
+/** return true if the solutions of 'A x=b' given by 'system' and
+ * by a new decomposition of 'A' are the same up to 'epsilon'. */
+template <unsigned int s>
+bool sameSolution(const SNupdatedPLU<double,s>& system,const SNvector<double,s>& b,double epsilon)
+{
+    auto x=system.solve(b);
+    auto y=system.getMatrix().getPLU().solve(b);
+    for (unsigned int i=0;i<s;++i)
+    {
+        if (std::abs(x.get(i)-y.get(i))>epsilon)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+class UpdatedPluTest : public CppUnit::TestCase
+{
+    private :
+        void rank_one_tests()
+        {
+            echo_function_test("rank_one_tests");
+            double epsilon(0.0000001);
+            auto A=pseudoRandomMatrix<20>();
+            SNupdatedPLU<double,20> system(A,4);
+            auto b=someVector<20>(1);
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+
+            echo_single_test("one update");
+            system.update(someVector<20>(2),someVector<20>(3));
+            CPPUNIT_ASSERT(system.getRank()==1);
+            CPPUNIT_ASSERT(system.getMatrix().get(0,0)==A.get(0,0)+someVector<20>(2).get(0)*someVector<20>(3).get(0));
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+
+            echo_single_test("more updates");
+            system.update(someVector<20>(4),someVector<20>(9));
+            system.update(someVector<20>(5),someVector<20>(1));
+            CPPUNIT_ASSERT(system.getRank()==3);
+            CPPUNIT_ASSERT(system.getRefactorCount()==0);
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+            CPPUNIT_ASSERT(sameSolution(system,someVector<20>(7),epsilon));
+        }
+        void refactor_tests()
+        {
+            echo_function_test("refactor_tests");
+            double epsilon(0.0000001);
+            SNupdatedPLU<double,20> system(pseudoRandomMatrix<20>(),3);
+            auto b=someVector<20>(6);
+
+            std::vector<SNvector<double,20>> U{someVector<20>(1),someVector<20>(2)};
+            std::vector<SNvector<double,20>> V{someVector<20>(8),someVector<20>(5)};
+            system.update(U,V);
+            CPPUNIT_ASSERT(system.getRank()==2);
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+
+            echo_single_test("over the maximal rank");
+            system.update(U,V);
+            CPPUNIT_ASSERT(system.getRank()==0);
+            CPPUNIT_ASSERT(system.getRefactorCount()==1);
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+
+            system.update(someVector<20>(3),someVector<20>(3));
+            CPPUNIT_ASSERT(system.getRank()==1);
+            CPPUNIT_ASSERT(sameSolution(system,b,epsilon));
+
+            echo_single_test("wrong sizes");
+            V.pop_back();
+            CPPUNIT_ASSERT_THROW(system.update(U,V),IncompatibleUpdateSizeException);
+        }
+        void near_singular_tests()
+        {
+            echo_function_test("near_singular_tests");
+
+            // u=-A e_0 and v=(1-delta)e_0 : the column 0 of A+uv^T is delta
+            // times the one of A, and I+v^TA^{-1}u is delta up to the rounding
+            // errors of A^{-1}u. That matrix is (numerically) singular : Woodbury
+            // is not used.
+            const double delta=1e-10;
+            auto A=pseudoRandomMatrix<6>(5);
+            SNvector<double,6> u;
+            SNvector<double,6> v;
+            for (unsigned int i=0;i<6;++i)
+            {
+                u.at(i)=-A.get(i,0);
+                v.at(i)=0;
+            }
+            v.at(0)=1-delta;
+            SNupdatedPLU<double,6> system(A,2);
+            system.update(u,v);
+            CPPUNIT_ASSERT(system.getRefactorCount()==1);
+            CPPUNIT_ASSERT(system.getRank()==0);
+
+            auto b=someVector<6>(2);
+            auto x=system.solve(b);
+            auto y=system.getMatrix().getPLU().solve(b);
+            for (unsigned int i=0;i<6;++i)
+            {
+                CPPUNIT_ASSERT(std::abs(x.get(i)-y.get(i))<=1e-12*std::abs(y.get(i))+1e-12);
+            }
+        }
+    public:
+        void runTest()
+        {
+            rank_one_tests();
+            refactor_tests();
+            near_singular_tests();
+        }
+};
+
+int main ()
+{
+    std::cout<<"UpdatedPluTest"<<std::endl;
+    UpdatedPluTest updated_plu_test;
+    updated_plu_test.runTest();
+}